@@ -0,0 +1,441 @@
+#include <hal/us_ticker_api.h>
+
+#include "acquisition.h"
+#include "drivers/l3gd20.h"
+#include "drivers/stm32f429i_discovery.h"
+
+// Event flags
+#define BLOCK_READY 1
+#define SAMPLES_READY 2
+
+// Board-level DMA completion hooks, bound to whichever reader is running
+static Callback<void()> dmaDone;
+static Callback<void()> dmaError;
+
+/*
+watermarkPin = Pin wired to the gyroscope's INT2 output
+*/
+GyroDma::GyroDma(PinName watermarkPin)
+    : watermarkLine(watermarkPin), samplePeriod(0), blockSize(1), writeIndex(0), readIndex(0),
+      filled(0), busy(false), errorCount(0)
+{
+}
+
+/*
+ctrlReg1 = CTRL_REG1 value, selects the ODR and enables the axes
+ctrlReg4 = CTRL_REG4 value, selects the full scale, must keep little-endian data
+watermark = FIFO level that raises INT2, and the number of samples per block,
+            1 to GYRO_FIFO_DEPTH - 1
+*/
+void GyroDma::start(uint8_t ctrlReg1, uint8_t ctrlReg4, int watermark)
+{
+    if (watermark < 1)
+    {
+        watermark = 1;
+    }
+    if (watermark > GYRO_FIFO_DEPTH - 1)
+    {
+        watermark = GYRO_FIFO_DEPTH - 1;
+    }
+    blockSize = watermark;
+
+    // DR bits of CTRL_REG1 select 95, 190, 380 or 760 Hz
+    samplePeriod = 1000000 / (95 << (ctrlReg1 >> 6));
+
+    // The driver keeps the control registers cached from here on
+    L3GD20_Init(ctrlReg1 | (ctrlReg4 << 8));
+    GYRO_IO_DMAInit();
+    dmaDone = callback(this, &GyroDma::onBurstDone);
+    dmaError = callback(this, &GyroDma::onBurstError);
+
+    // Going through bypass discards anything left over from a previous run
+    L3GD20_FIFOConfig(L3GD20_FIFOMODE_BYPASS, 0);
+    L3GD20_FIFOCmd(L3GD20_FIFO_ENABLE);
+    L3GD20_FIFOConfig(L3GD20_FIFOMODE_STREAM, watermark);
+    L3GD20_INT2InterruptConfig(L3GD20_INT2WATERMARK_ENABLE);
+
+    watermarkLine.rise(callback(this, &GyroDma::onWatermark));
+
+    core_util_critical_section_enter();
+    bool blockReady = startBurst();
+    core_util_critical_section_exit();
+
+    if (blockReady)
+    {
+        flags.set(BLOCK_READY);
+    }
+}
+
+/*
+samples = Receives the block in arrival order
+maxSamples = Room in samples, at least the watermark to take whole blocks
+
+Blocks until a buffer has been filled and copies it out, see acquire() to
+use the buffer in place.
+
+Returns the number of samples written
+*/
+int GyroDma::read(GyroSample *samples, int maxSamples)
+{
+    int count;
+    const int16_t *xyz = acquire(&count);
+    uint32_t newest = burstTime[readIndex];
+
+    if (count > maxSamples)
+    {
+        count = maxSamples;
+    }
+    for (int i = 0; i < count; i++)
+    {
+        samples[i].x = xyz[3 * i];
+        samples[i].y = xyz[3 * i + 1];
+        samples[i].z = xyz[3 * i + 2];
+        samples[i].timestamp = newest - (count - 1 - i) * samplePeriod;
+    }
+
+    release();
+    return count;
+}
+
+/*
+count = Receives the number of samples in the block
+
+Blocks until a buffer has been filled. The buffer stays valid, and is not
+refilled, until release() is called.
+
+Returns the samples as interleaved X, Y, Z raw readings
+*/
+const int16_t *GyroDma::acquire(int *count)
+{
+    while (filled == 0)
+    {
+        flags.wait_any(BLOCK_READY);
+    }
+
+    *count = blockSize;
+    return buffers[readIndex];
+}
+
+// Hands the buffer returned by acquire() back for the next burst
+void GyroDma::release()
+{
+    core_util_critical_section_enter();
+    readIndex ^= 1;
+    filled--;
+
+    // The watermark may have been reached while both buffers were taken
+    bool blockReady = startBurst();
+    core_util_critical_section_exit();
+
+    if (blockReady)
+    {
+        flags.set(BLOCK_READY);
+    }
+}
+
+// Bursts the DMA refused or failed since construction
+int GyroDma::errors() const
+{
+    return errorCount;
+}
+
+/*
+Called with interrupts masked, or from an interrupt of the same priority
+
+Returns true when a block was filled without DMA and is ready for the consumer
+*/
+bool GyroDma::startBurst()
+{
+    bool blockReady = false;
+
+    // One buffer is always left to the consumer, the FIFO absorbs the wait
+    while (!busy && filled < 2 && watermarkLine.read())
+    {
+        busy = true;
+        burstTime[writeIndex] = us_ticker_read();
+        if (GYRO_IO_ReadDMA((uint8_t *)buffers[writeIndex], L3GD20_OUT_X_L_ADDR, 6 * blockSize) == HAL_OK)
+        {
+            break;
+        }
+
+        // INT2 only falls once the FIFO drops below the watermark, so a
+        // refused burst is read by the CPU or acquisition would stall
+        GYRO_IO_Read((uint8_t *)buffers[writeIndex], L3GD20_OUT_X_L_ADDR, 6 * blockSize);
+        errorCount++;
+        busy = false;
+        writeIndex ^= 1;
+        filled++;
+        blockReady = true;
+    }
+
+    return blockReady;
+}
+
+void GyroDma::onWatermark()
+{
+    core_util_critical_section_enter();
+    bool blockReady = startBurst();
+    core_util_critical_section_exit();
+
+    if (blockReady)
+    {
+        flags.set(BLOCK_READY);
+    }
+}
+
+void GyroDma::onBurstDone()
+{
+    core_util_critical_section_enter();
+    busy = false;
+    writeIndex ^= 1;
+    filled++;
+
+    // INT2 is a level, a FIFO still above the watermark raises no new edge
+    startBurst();
+    core_util_critical_section_exit();
+
+    flags.set(BLOCK_READY);
+}
+
+void GyroDma::onBurstError()
+{
+    core_util_critical_section_enter();
+    busy = false;
+    errorCount++;
+    bool blockReady = startBurst();
+    core_util_critical_section_exit();
+
+    if (blockReady)
+    {
+        flags.set(BLOCK_READY);
+    }
+}
+
+/*
+dataReadyPin = Pin wired to the gyroscope's INT2 output
+*/
+GyroDrdy::GyroDrdy(PinName dataReadyPin)
+    : dataReady(dataReadyPin), edgeTime(0), edgePending(false), retrying(false), retryTime(0),
+      target(nullptr),
+      batchSize(1), droppedCount(0), errorCount(0)
+{
+}
+
+/*
+ctrlReg1 = CTRL_REG1 value, selects the ODR and enables the axes
+ctrlReg4 = CTRL_REG4 value, selects the full scale, must keep little-endian data
+batchSize = Samples gathered before read() wakes up, 1 to GYRO_RING_SIZE
+*/
+void GyroDrdy::start(uint8_t ctrlReg1, uint8_t ctrlReg4, int batchSize)
+{
+    if (batchSize < 1)
+    {
+        batchSize = 1;
+    }
+    if (batchSize > GYRO_RING_SIZE)
+    {
+        batchSize = GYRO_RING_SIZE;
+    }
+    this->batchSize = batchSize;
+
+    // The driver keeps the control registers cached from here on
+    L3GD20_Init(ctrlReg1 | (ctrlReg4 << 8));
+    GYRO_IO_DMAInit();
+    dmaDone = callback(this, &GyroDrdy::onReadDone);
+    dmaError = callback(this, &GyroDrdy::onReadError);
+
+    // Output registers straight from the sensor, no FIFO in between
+    L3GD20_FIFOConfig(L3GD20_FIFOMODE_BYPASS, 0);
+    L3GD20_FIFOCmd(L3GD20_FIFO_DISABLE);
+    L3GD20_INT2InterruptConfig(L3GD20_INT2INTERRUPT_ENABLE);
+
+    clock.reset();
+    edgePending = false;
+    dataReady.rise(callback(this, &GyroDrdy::onDataReady));
+
+    // A sample that became ready before the edge was armed would hold DRDY high
+    core_util_critical_section_enter();
+    bool batchReady = startRead();
+    core_util_critical_section_exit();
+
+    if (batchReady)
+    {
+        flags.set(SAMPLES_READY);
+    }
+}
+
+/*
+samples = Receives the oldest samples in arrival order
+maxSamples = Room in samples
+
+Blocks until at least the batch size has been gathered, the consumer
+side of the ring. Must only be called from one thread.
+
+Returns the number of samples written
+*/
+int GyroDrdy::read(GyroSample *samples, int maxSamples)
+{
+    int wanted = batchSize < maxSamples ? batchSize : maxSamples;
+    while (ring.size() < wanted)
+    {
+        flags.wait_any(SAMPLES_READY);
+    }
+
+    return ring.pop(samples, maxSamples);
+}
+
+// Snapshot of the sample interval statistics
+SampleClock GyroDrdy::timing() const
+{
+    core_util_critical_section_enter();
+    SampleClock snapshot = clock;
+    core_util_critical_section_exit();
+    return snapshot;
+}
+
+// Samples discarded because the ring was full
+int GyroDrdy::dropped() const
+{
+    return droppedCount;
+}
+
+// Reads the DMA refused or failed since construction
+int GyroDrdy::errors() const
+{
+    return errorCount;
+}
+
+/*
+The producer side of the ring, called with interrupts masked or from an
+interrupt of the same priority
+
+Returns true when samples read without DMA completed a batch
+*/
+bool GyroDrdy::startRead()
+{
+    bool batchReady = false;
+
+    while (target == nullptr && dataReady.read())
+    {
+        // The edge interrupt's stamp, or now for a sample that was already
+        // ready when the line was armed. A repeated read keeps its first stamp
+        // and is not counted again.
+        uint32_t now;
+        if (retrying)
+        {
+            now = retryTime;
+            retrying = false;
+        }
+        else
+        {
+            now = edgePending ? edgeTime : us_ticker_read();
+            edgePending = false;
+            clock.tick(now);
+        }
+
+        // DRDY only falls once the sample is read, so a sample with nowhere
+        // to go is still read, into scratch, or the line would stay high
+        target = ring.claim();
+        if (target == nullptr)
+        {
+            target = &scratch;
+            droppedCount++;
+        }
+        target->timestamp = now;
+
+        if (GYRO_IO_ReadDMA((uint8_t *)&target->x, L3GD20_OUT_X_L_ADDR, 6) == HAL_OK)
+        {
+            break;
+        }
+
+        // Same reason, a read the DMA refused is done by the CPU instead
+        GYRO_IO_Read((uint8_t *)&target->x, L3GD20_OUT_X_L_ADDR, 6);
+        errorCount++;
+        batchReady |= finishRead();
+    }
+
+    return batchReady;
+}
+
+/*
+Publishes the sample that was just read and frees the bus
+
+Returns true when the ring now holds a batch
+*/
+bool GyroDrdy::finishRead()
+{
+    bool batchReady = false;
+    if (target != &scratch)
+    {
+        ring.publish();
+        batchReady = ring.size() >= batchSize;
+    }
+    target = nullptr;
+    return batchReady;
+}
+
+void GyroDrdy::onDataReady()
+{
+    // Stamped before anything else, the read may still have to wait for the bus
+    uint32_t now = us_ticker_read();
+
+    core_util_critical_section_enter();
+    edgeTime = now;
+    edgePending = true;
+    bool batchReady = startRead();
+    core_util_critical_section_exit();
+
+    if (batchReady)
+    {
+        flags.set(SAMPLES_READY);
+    }
+}
+
+void GyroDrdy::onReadDone()
+{
+    core_util_critical_section_enter();
+    bool batchReady = finishRead();
+
+    // The next sample may have become ready while this one was read
+    batchReady |= startRead();
+    core_util_critical_section_exit();
+
+    if (batchReady)
+    {
+        flags.set(SAMPLES_READY);
+    }
+}
+
+void GyroDrdy::onReadError()
+{
+    // While DRDY is still high the sample is read again into the same slot
+    core_util_critical_section_enter();
+    retrying = target != nullptr;
+    retryTime = retrying ? target->timestamp : 0;
+    target = nullptr;
+    errorCount++;
+    bool batchReady = startRead();
+    retrying = false;
+    core_util_critical_section_exit();
+
+    if (batchReady)
+    {
+        flags.set(SAMPLES_READY);
+    }
+}
+
+extern "C" void GYRO_IO_ReadDMACpltCallback(void)
+{
+    if (dmaDone)
+    {
+        dmaDone();
+    }
+}
+
+extern "C" void GYRO_IO_ReadDMAErrorCallback(void)
+{
+    if (dmaError)
+    {
+        dmaError();
+    }
+}
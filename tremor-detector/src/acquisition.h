@@ -0,0 +1,115 @@
+#ifndef ACQUISITION_H
+#define ACQUISITION_H
+
+#include <mbed.h>
+
+#include "spsc.h"
+#include "timing.h"
+
+#define GYRO_FIFO_DEPTH 32 // Samples held by the L3GD20 FIFO
+#define GYRO_RING_SIZE 64  // Samples GyroDrdy can hold for a slow consumer, about 0.7s at 95 Hz
+
+struct GyroSample
+{
+    int16_t x;          // Raw readings, written by DMA in register order
+    int16_t y;
+    int16_t z;
+    uint32_t timestamp; // Microseconds at the data-ready edge
+};
+
+/*
+L3GD20 FIFO acquisition through the board support SPI link, with the
+bursts moved by DMA into a pair of ping-pong buffers. The watermark
+interrupt starts a burst straight into the free buffer, and the DMA
+completion hands it to the consumer while the next burst can already
+be in flight. The CPU only sends the address byte of each burst.
+
+read() has the same shape as GyroDrdy::read(), so either can feed the
+processing, but the timestamps are only estimated: the burst start
+stands in for the arrival of the newest sample of the block, and the
+others are spaced by the nominal ODR.
+
+Only one instance can exist, the DMA completion is a board-level hook.
+*/
+class GyroDma
+{
+public:
+    GyroDma(PinName watermarkPin);
+
+    void start(uint8_t ctrlReg1, uint8_t ctrlReg4, int watermark);
+    int read(GyroSample *samples, int maxSamples);
+    const int16_t *acquire(int *count);
+    void release();
+
+    int errors() const;
+
+    void onBurstDone();
+    void onBurstError();
+
+private:
+    bool startBurst();
+    void onWatermark();
+
+    InterruptIn watermarkLine;
+    EventFlags flags;
+
+    int16_t buffers[2][3 * GYRO_FIFO_DEPTH];
+    uint32_t burstTime[2];   // Microseconds at the start of each buffer's burst
+    uint32_t samplePeriod;   // Nominal sample period in microseconds
+    int blockSize;
+    int writeIndex;          // Buffer the next burst goes to
+    int readIndex;           // Buffer handed out by acquire()
+    volatile int filled;     // Buffers holding data not yet released
+    volatile bool busy;      // A burst is in flight
+    volatile int errorCount;
+};
+
+/*
+L3GD20 acquisition clocked by its data-ready line. Every DRDY edge on
+INT2 is timestamped from the microsecond hardware ticker in the edge
+interrupt itself, before any wait for the bus, and starts a DMA read of that one sample, so the sample period is set by the sensor
+oscillator rather than by how long the processing took. The DMA writes
+straight into a claimed slot of a wait-free ring, which a processing
+thread drains in batches with read(). The timestamps feed a SampleClock
+that reports the measured interval jitter.
+
+Shares the DMA completion hook with GyroDma, only one of them can run.
+*/
+class GyroDrdy
+{
+public:
+    GyroDrdy(PinName dataReadyPin);
+
+    void start(uint8_t ctrlReg1, uint8_t ctrlReg4, int batchSize);
+    int read(GyroSample *samples, int maxSamples);
+
+    SampleClock timing() const;
+    int dropped() const;
+    int errors() const;
+
+    void onReadDone();
+    void onReadError();
+
+private:
+    bool startRead();
+    bool finishRead();
+    void onDataReady();
+
+    InterruptIn dataReady;
+    EventFlags flags;
+    SampleClock clock;
+
+    volatile uint32_t edgeTime; // Ticker at the last edge not yet read
+    volatile bool edgePending;
+    bool retrying;              // A failed read is repeated under retryTime
+    uint32_t retryTime;
+
+    SpscRing<GyroSample, GYRO_RING_SIZE> ring;
+    GyroSample scratch;      // Read target when the ring is full
+    GyroSample *target;      // Sample being read, null when the bus is idle
+    int batchSize;
+    volatile int droppedCount;
+    volatile int errorCount;
+};
+
+#endif /* ACQUISITION_H */
@@ -0,0 +1,249 @@
+#ifndef DECIMATOR_H
+#define DECIMATOR_H
+
+#include "fft.h"
+#include "samplering.h"
+
+#define DECIMATOR_TAPS_PER_PHASE 10 // FIR taps per unit of decimation factor
+#define DECIMATOR_MAX_STAGE 5       // Largest factor a stage takes when the total splits further
+
+/*
+factor = Decimation factor still to be applied
+
+Returns the factor of the next stage: the largest divisor up to
+DECIMATOR_MAX_STAGE so the rate drops as early as possible, or else the
+smallest prime factor, taken whole
+*/
+constexpr int decimatorStage(int factor)
+{
+    for (int s = DECIMATOR_MAX_STAGE; s > 1; s--)
+    {
+        if (factor % s == 0)
+        {
+            return s;
+        }
+    }
+    for (int s = DECIMATOR_MAX_STAGE + 1; s < factor; s++)
+    {
+        if (factor % s == 0)
+        {
+            return s;
+        }
+    }
+    return factor;
+}
+
+template <int Taps>
+struct DecimatorTable
+{
+    float coef[Taps];
+};
+
+/*
+Hamming-windowed sinc low-pass with unity gain at DC and its cutoff at the
+output Nyquist frequency. With DECIMATOR_TAPS_PER_PHASE taps per unit of
+factor the passband is flat to 0.3 of the output rate and everything from
+0.7 of it, the part that would fold back below 0.3, is at least 50 dB down.
+At 95 Hz in and 19 Hz out that keeps 0 to 6 Hz and rejects 13 Hz and up,
+the aliases in between land above the tremor band.
+*/
+template <int Taps>
+constexpr DecimatorTable<Taps> makeDecimatorTable(int factor)
+{
+    DecimatorTable<Taps> t = {};
+    double cutoff = 0.5 / factor; // Cycles per input sample
+    double centre = (Taps - 1) / 2.0;
+    double coef[Taps] = {};
+    double sum = 0.0;
+
+    for (int k = 0; k < Taps; k++)
+    {
+        double x = k - centre;
+        double sinc = (x == 0.0) ? 2 * cutoff : constexprSin(2 * FFT_PI * cutoff * x) / (FFT_PI * x);
+        double w = 0.54 - 0.46 * constexprCos(2 * FFT_PI * k / (Taps - 1));
+        coef[k] = sinc * w;
+        sum += coef[k];
+    }
+    for (int k = 0; k < Taps; k++)
+    {
+        t.coef[k] = (float)(coef[k] / sum);
+    }
+    return t;
+}
+
+/*
+One decimating direct-form FIR stage. The filter is only evaluated at the
+output instants, so it costs DECIMATOR_TAPS_PER_PHASE multiply-accumulates
+per input sample whatever the factor. The coefficients are built by the
+compiler and shared by every stage of the same factor.
+*/
+template <int Factor>
+class FirDecimator
+{
+public:
+    static constexpr int taps = DECIMATOR_TAPS_PER_PHASE * Factor;
+
+    FirDecimator() : line(Factor)
+    {
+    }
+
+    void reset()
+    {
+        line.reset();
+    }
+
+    /*
+    sample = Newest input sample
+    out = Receives the output sample when one is produced
+
+    Returns true when an output sample was produced, every Factor samples
+    once the delay line has filled
+    */
+    bool push(float sample, float *out)
+    {
+        if (!line.push(sample))
+        {
+            return false;
+        }
+
+        // Oldest sample first
+        const float *x = line.window();
+        float acc = 0.0f;
+        for (int k = 0; k < taps; k++)
+        {
+            acc += table.coef[k] * x[k];
+        }
+        *out = acc;
+        return true;
+    }
+
+    static constexpr DecimatorTable<taps> table = makeDecimatorTable<taps>(Factor);
+
+private:
+    SampleRing<float, taps> line; // Hops by the factor
+};
+
+template <int Factor>
+constexpr int FirDecimator<Factor>::taps;
+
+template <int Factor>
+constexpr DecimatorTable<FirDecimator<Factor>::taps> FirDecimator<Factor>::table;
+
+// Cascade of FIR stages making up Factor, see decimatorStage()
+template <int Factor>
+class DecimatorStages
+{
+    static constexpr int stage = decimatorStage(Factor);
+
+public:
+    void reset()
+    {
+        first.reset();
+        rest.reset();
+    }
+
+    bool push(float sample, float *out)
+    {
+        float value;
+        if (!first.push(sample, &value))
+        {
+            return false;
+        }
+        return rest.push(value, out);
+    }
+
+    // Group delay in input samples
+    static constexpr float delay()
+    {
+        return (FirDecimator<stage>::taps - 1) / 2.0f + stage * DecimatorStages<Factor / stage>::delay();
+    }
+
+private:
+    FirDecimator<stage> first;
+    DecimatorStages<Factor / stage> rest;
+};
+
+template <>
+class DecimatorStages<1>
+{
+public:
+    void reset()
+    {
+    }
+
+    bool push(float sample, float *out)
+    {
+        *out = sample;
+        return true;
+    }
+
+    static constexpr float delay()
+    {
+        return 0.0f;
+    }
+};
+
+/*
+Multi-stage decimator taking the sensor rate down to the analysis rate.
+The factor is split into stages of at most DECIMATOR_MAX_STAGE where it
+can be, so each FIR stays short while its transition band stays wide.
+Storage is sized for the stages Factor actually needs.
+*/
+template <int Factor>
+class Decimator
+{
+    static_assert(Factor >= 1, "Decimator factor must be at least 1");
+
+public:
+    static constexpr int factor = Factor;
+
+    void reset()
+    {
+        stages.reset();
+    }
+
+    /*
+    sample = Newest sample at the sensor rate
+    out = Receives the output sample when one is produced
+
+    Returns true when an output sample was produced
+    */
+    bool push(float sample, float *out)
+    {
+        return stages.push(sample, out);
+    }
+
+    /*
+    in = Block of samples at the sensor rate
+    size = Number of samples in the block
+    out = Receives the decimated samples, room for size / Factor + 1 is enough
+
+    Returns the number of samples written to out
+    */
+    int process(const float *in, int size, float *out)
+    {
+        int written = 0;
+        for (int n = 0; n < size; n++)
+        {
+            if (push(in[n], &out[written]))
+            {
+                written++;
+            }
+        }
+        return written;
+    }
+
+    // Group delay of the whole cascade in input samples
+    static constexpr float delay()
+    {
+        return DecimatorStages<Factor>::delay();
+    }
+
+private:
+    DecimatorStages<Factor> stages;
+};
+
+template <int Factor>
+constexpr int Decimator<Factor>::factor;
+
+#endif /* DECIMATOR_H */
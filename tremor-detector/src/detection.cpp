@@ -2,25 +2,79 @@
 #include <stdio.h>
 #include <math.h>
 
-#define MIN_FREQ 3 // Min frequency of desired tremor
-#define MAX_FREQ 6 // Max frequency of desired tremor
 #define INTENSITY_SCALING_FACTOR 10
+#define SNR_LOBE_BINS 2      // Bins either side of a peak left out of its noise estimate
+#define SNR_MIN_NOISE_BINS 4 // Fewest bins the noise estimate is averaged over
+
+// Band searched by the single-band detectors, see setTremorBand()
+static float tremorMinFreq = 3;
+static float tremorMaxFreq = 6;
+
+// Clinically relevant bands, split so every bin belongs to one class. Rest
+// and essential tremor overlap around 4-6 Hz, frequency alone cannot tell
+// them apart there, so the boundary sits between their typical peaks.
+const TremorBand defaultTremorBands[] = {
+    {0.5f, 3.0f, TREMOR_VOLUNTARY},
+    {3.0f, 5.5f, TREMOR_REST},
+    {5.5f, 8.0f, TREMOR_ESSENTIAL},
+    {8.0f, 12.0f, TREMOR_PHYSIOLOGICAL},
+};
+const int defaultTremorBandCount = sizeof(defaultTremorBands) / sizeof(defaultTremorBands[0]);
 
 /*
-power = Power of signal
-size = Size of power array
+minFreq, maxFreq = Frequency range of the band in Hz
+size = Number of dft points
 sampleRate = Sampling rate of the original signal
+minI, maxI = Range of bins covering the band
+*/
+static void bandBins(float minFreq, float maxFreq, int size, int sampleRate, int *minI, int *maxI)
+{
+    *minI = floor((minFreq * size) / (float)sampleRate);
+    *maxI = ceil((maxFreq * size) / (float)sampleRate);
+    if (*minI < 0)
+    {
+        *minI = 0;
+    }
+    if (*maxI > size / 2)
+    {
+        *maxI = size / 2;
+    }
+}
 
-Returns an intensity value based on the max magnitude of a peak in a frequency range
+static void tremorBins(int size, int sampleRate, int *minI, int *maxI)
+{
+    bandBins(tremorMinFreq, tremorMaxFreq, size, sampleRate, minI, maxI);
+}
+
+/*
+minFreq = Min frequency of desired tremor
+maxFreq = Max frequency of desired tremor
+
+Sets the band used by detectPeakIntensity(), detectPeakIntensityFixed() and detectPeak()
 */
-int detectPeakIntensity(float *power, int size, int sampleRate)
+void setTremorBand(float minFreq, float maxFreq)
+{
+    tremorMinFreq = minFreq;
+    tremorMaxFreq = maxFreq;
+}
+
+/*
+power = Power of signal, only the N / 2 + 1 bins written by rdft() are read
+size = Number of dft points N used to compute power
+sampleRate = Sampling rate of the original signal
+coherentGain = Coherent gain of the window applied before the dft, see Fft<N>::coherentGain()
+
+Returns an intensity value based on the max magnitude of a peak in a frequency range,
+calibrated so the same tone reads the same under any window
+*/
+int detectPeakIntensity(float *power, int size, int sampleRate, float coherentGain)
 {
     float maxMag = 0.0;
     int peakIndex = -1;
 
     // Corresponding indices for desired frequencies
-    int minI = floor((MIN_FREQ * size) / (float)sampleRate);
-    int maxI = ceil((MIN_FREQ * size) / (float)sampleRate);
+    int minI, maxI;
+    tremorBins(size, sampleRate, &minI, &maxI);
 
     // Finding max magnitude in the desired frequency range
     for (int i = minI; i <= maxI; i++)
@@ -37,5 +91,263 @@ int detectPeakIntensity(float *power, int size, int sampleRate)
         return 0;
     }
 
-    return (int)(maxMag);
+    return (int)(maxMag / (coherentGain * coherentGain));
+}
+
+// Strongest peak between bins minI and maxI, interpolated between bins
+static TremorPeak peakInBins(const float *power, int size, int sampleRate, int minI, int maxI, float coherentGain)
+{
+    TremorPeak peak = {0.0f, 0.0f, -1, 0.0f};
+    float maxMag = 0.0;
+
+    for (int i = minI; i <= maxI; i++)
+    {
+        if (power[i] > maxMag)
+        {
+            maxMag = power[i];
+            peak.bin = i;
+        }
+    }
+
+    if (peak.bin == -1)
+    {
+        return peak;
+    }
+
+    // Parabolic fit through the log-power of the peak and its neighbours,
+    // exact for a Gaussian-shaped main lobe. A band edge that sits on the
+    // slope of a stronger peak outside the band is left uninterpolated.
+    float offset = 0.0f;
+    float peakPower = maxMag;
+    int k = peak.bin;
+    if (k > 0 && k < size / 2 && power[k - 1] > 0.0f && power[k + 1] > 0.0f &&
+        power[k] >= power[k - 1] && power[k] >= power[k + 1])
+    {
+        float a = logf(power[k - 1]);
+        float b = logf(power[k]);
+        float c = logf(power[k + 1]);
+        float denom = a - 2.0f * b + c;
+        if (denom < 0.0f)
+        {
+            offset = 0.5f * (a - c) / denom;
+            peakPower = expf(b - 0.25f * (a - c) * offset);
+        }
+    }
+
+    peak.frequency = (k + offset) * sampleRate / (float)size;
+    peak.power = peakPower / (coherentGain * coherentGain);
+
+    // Background is the searched band outside the main lobe of a Hann
+    // window, widened when the band is too narrow to leave enough bins.
+    // DC is excluded.
+    int lo = minI < 1 ? 1 : minI;
+    int hi = maxI;
+    int noiseBins = 0;
+    for (;;)
+    {
+        noiseBins = 0;
+        for (int i = lo; i <= hi; i++)
+        {
+            if (i < k - SNR_LOBE_BINS || i > k + SNR_LOBE_BINS)
+            {
+                noiseBins++;
+            }
+        }
+        if (noiseBins >= SNR_MIN_NOISE_BINS || (lo <= 1 && hi >= size / 2))
+        {
+            break;
+        }
+        if (lo > 1)
+        {
+            lo--;
+        }
+        if (hi < size / 2)
+        {
+            hi++;
+        }
+    }
+
+    float noise = 0.0f;
+    for (int i = lo; i <= hi; i++)
+    {
+        if (i < k - SNR_LOBE_BINS || i > k + SNR_LOBE_BINS)
+        {
+            noise += power[i];
+        }
+    }
+    if (noiseBins > 0 && noise > 0.0f)
+    {
+        peak.snr = maxMag / (noise / noiseBins);
+    }
+
+    return peak;
+}
+
+/*
+power = Power of signal, only the N / 2 + 1 bins written by rdft() are read
+size = Number of dft points N used to compute power
+sampleRate = Sampling rate of the original signal
+coherentGain = Coherent gain of the window applied before the dft
+
+Returns the strongest peak in the tremor band with its frequency and power
+interpolated between bins, so precision does not depend on a larger dft
+*/
+TremorPeak detectPeak(const float *power, int size, int sampleRate, float coherentGain)
+{
+    int minI, maxI;
+    tremorBins(size, sampleRate, &minI, &maxI);
+    return peakInBins(power, size, sampleRate, minI, maxI, coherentGain);
+}
+
+/*
+minFreq, maxFreq = Search window in Hz, e.g. from PeakTracker::searchWindow()
+
+Same as detectPeak() but only searches the given window
+*/
+TremorPeak detectPeakNear(const float *power, int size, int sampleRate, float minFreq, float maxFreq, float coherentGain)
+{
+    int minI, maxI;
+    bandBins(minFreq, maxFreq, size, sampleRate, &minI, &maxI);
+    return peakInBins(power, size, sampleRate, minI, maxI, coherentGain);
+}
+
+/*
+power = Q31 power spectrum from rdftFixed()
+exponent = Exponent returned by rdftFixed()
+size = Number of dft points N used to compute power
+sampleRate = Sampling rate of the original signal
+
+Integer variant of detectPeakIntensity() for the fixed-point pipeline
+*/
+int detectPeakIntensityFixed(const int32_t *power, int exponent, int size, int sampleRate)
+{
+    int32_t maxMag = 0;
+    int peakIndex = -1;
+
+    int minI, maxI;
+    tremorBins(size, sampleRate, &minI, &maxI);
+
+    for (int i = minI; i <= maxI; i++)
+    {
+        if (power[i] > maxMag)
+        {
+            maxMag = power[i];
+            peakIndex = i;
+        }
+    }
+
+    if (peakIndex == -1)
+    {
+        return 0;
+    }
+
+    if (exponent <= 0)
+    {
+        return exponent > -32 ? (int)(maxMag >> -exponent) : 0;
+    }
+    if (exponent >= 31 || maxMag > (INT32_MAX >> exponent))
+    {
+        return INT32_MAX;
+    }
+    return (int)(maxMag << exponent);
+}
+
+/*
+power = Power of signal, only the N / 2 + 1 bins written by rdft() are read
+size = Number of dft points N used to compute power
+sampleRate = Sampling rate of the original signal
+bands = Band table, at most MAX_TREMOR_BANDS entries
+bandCount = Number of bands
+stats = Receives one entry per band
+
+Fills the statistics of every band in a single sweep over the spectrum.
+A band holds the bins from minFreq up to but excluding maxFreq, so
+adjacent bands never share a bin.
+*/
+void analyseBands(const float *power, int size, int sampleRate, const TremorBand *bands, int bandCount, BandStats *stats)
+{
+    int minI[MAX_TREMOR_BANDS], maxI[MAX_TREMOR_BANDS];
+
+    if (bandCount > MAX_TREMOR_BANDS)
+    {
+        bandCount = MAX_TREMOR_BANDS;
+    }
+
+    for (int b = 0; b < bandCount; b++)
+    {
+        minI[b] = ceil((bands[b].minFreq * size) / (float)sampleRate);
+        maxI[b] = ceil((bands[b].maxFreq * size) / (float)sampleRate) - 1;
+        if (maxI[b] > size / 2)
+        {
+            maxI[b] = size / 2;
+        }
+        stats[b].energy = 0.0f;
+        stats[b].peak = 0.0f;
+        stats[b].peakFrequency = 0.0f;
+        stats[b].relativePower = 0.0f;
+        stats[b].peakBin = -1;
+    }
+
+    float total = 0.0f;
+    for (int i = 1; i <= size / 2; i++)
+    {
+        float p = power[i];
+        total += p;
+
+        for (int b = 0; b < bandCount; b++)
+        {
+            if (i < minI[b] || i > maxI[b])
+            {
+                continue;
+            }
+
+            stats[b].energy += p;
+            if (stats[b].peakBin == -1 || p > stats[b].peak)
+            {
+                stats[b].peak = p;
+                stats[b].peakBin = i;
+            }
+        }
+    }
+
+    for (int b = 0; b < bandCount; b++)
+    {
+        stats[b].peakFrequency = stats[b].peakBin * sampleRate / (float)size;
+        if (total > 0.0f)
+        {
+            stats[b].relativePower = stats[b].energy / total;
+        }
+    }
+}
+
+/*
+bands = Band table passed to analyseBands()
+stats = Statistics filled by analyseBands()
+bandCount = Number of bands
+minRelativePower = Share of the total power the winning band needs, e.g. 0.3
+
+Returns the label of the band holding the strongest peak. With
+overlapping bands a shared peak goes to the first band listed.
+*/
+TremorClass classifyTremor(const TremorBand *bands, const BandStats *stats, int bandCount, float minRelativePower)
+{
+    int best = -1;
+
+    for (int b = 0; b < bandCount; b++)
+    {
+        if (stats[b].peakBin == -1)
+        {
+            continue;
+        }
+        if (best == -1 || stats[b].peak > stats[best].peak)
+        {
+            best = b;
+        }
+    }
+
+    if (best == -1 || stats[best].relativePower < minRelativePower)
+    {
+        return TREMOR_NONE;
+    }
+    return bands[best].label;
 }
@@ -1,5 +1,51 @@
 #ifndef DETECTION_H
 #define DETECTION_H
 
-int detectPeakIntensity(float *mag, int size, int sampleRate);
+#include <stdint.h>
+
+#define MAX_TREMOR_BANDS 8 // Most bands analyseBands() accepts
+
+enum TremorClass
+{
+    TREMOR_NONE,
+    TREMOR_VOLUNTARY,
+    TREMOR_REST,
+    TREMOR_ESSENTIAL,
+    TREMOR_PHYSIOLOGICAL
+};
+
+struct TremorBand
+{
+    float minFreq;     // Lowest frequency of the band in Hz
+    float maxFreq;     // Highest frequency of the band in Hz
+    TremorClass label; // Class reported when this band dominates
+};
+
+struct BandStats
+{
+    float energy;        // Summed power of the band
+    float peak;          // Power of the strongest bin
+    float peakFrequency; // Frequency of the strongest bin in Hz
+    float relativePower; // Share of the total power, DC excluded
+    int peakBin;         // Strongest bin, -1 for a band outside the spectrum
+};
+
+extern const TremorBand defaultTremorBands[];
+extern const int defaultTremorBandCount;
+
+struct TremorPeak
+{
+    float frequency; // Interpolated peak frequency in Hz
+    float power;     // Interpolated peak power, calibrated for the window
+    int bin;         // Strongest bin in the band, -1 when there is no peak
+    float snr;       // Peak power over the mean power of the searched band outside its main lobe
+};
+
+int detectPeakIntensity(float *mag, int size, int sampleRate, float coherentGain = 1.0f);
+int detectPeakIntensityFixed(const int32_t *power, int exponent, int size, int sampleRate);
+TremorPeak detectPeak(const float *power, int size, int sampleRate, float coherentGain = 1.0f);
+TremorPeak detectPeakNear(const float *power, int size, int sampleRate, float minFreq, float maxFreq, float coherentGain = 1.0f);
+void setTremorBand(float minFreq, float maxFreq);
+void analyseBands(const float *power, int size, int sampleRate, const TremorBand *bands, int bandCount, BandStats *stats);
+TremorClass classifyTremor(const TremorBand *bands, const BandStats *stats, int bandCount, float minRelativePower);
 #endif /* DETECTION_H */
\ No newline at end of file
@@ -2,29 +2,186 @@
 #include <stdio.h>
 
 #include "dft.h"
+#include "fft.h"
 
 #define PI 3.1415926535897932385
 
+// Twiddle factors e^(-2*pi*i*k/twiddleN), rebuilt only when a longer or
+// incompatible length is requested
+static float twiddleCos[FFT_MAX_POINTS / 2];
+static float twiddleSin[FFT_MAX_POINTS / 2];
+static int twiddleN = 0;
+
+// Packed half-length signal for the real-input transform
+static float workReal[FFT_MAX_POINTS / 2];
+static float workImag[FFT_MAX_POINTS / 2];
+
+static bool isPowerOfTwo(int n)
+{
+    return n > 0 && (n & (n - 1)) == 0;
+}
+
 /*
-x = The input signal
-size = Number of points in the signal
-N = Number of dft points
-power = Power spectrum of DFT
+N = Transform length the twiddles are needed for
+
+Returns the stride into the twiddle table that yields e^(-2*pi*i*k/N)
 */
-void dft(float *x, int size, int N, float *power)
+static int buildTwiddles(int N)
+{
+    if (twiddleN >= N && twiddleN % N == 0)
+    {
+        return twiddleN / N;
+    }
+
+    for (int k = 0; k < N / 2; k++)
+    {
+        twiddleCos[k] = (float)cos(2 * PI * k / N);
+        twiddleSin[k] = (float)-sin(2 * PI * k / N);
+    }
+    twiddleN = N;
+    return 1;
+}
+
+// Direct evaluation for lengths the FFT cannot handle
+static void directDft(float *x, int size, int N, int bins, float *power)
 {
     float Xreal, Ximag;
-    for (int k = 0; k < N; k++)
+    for (int k = 0; k < bins; k++)
     {
-        Xreal = 0.0;
-        Ximag = 0.0;
+        Xreal = 0.0f;
+        Ximag = 0.0f;
 
         for (int n = 0; n < size; n++)
         {
-            Xreal += x[n] * cos(2 * PI * k * n / N);
-            Ximag -= x[n] * sin(2 * PI * k * n / N);
+            float angle = (float)(2 * PI) * (float)((k * n) % N) / N;
+            Xreal += x[n] * cosf(angle);
+            Ximag -= x[n] * sinf(angle);
         }
 
         power[k] = ((Xreal * Xreal) + (Ximag * Ximag)) / size;
     }
 }
+
+static void fftCore(float *re, float *im, int N, int stride)
+{
+    // Bit-reversal permutation
+    for (int i = 1, j = 0; i < N; i++)
+    {
+        int bit = N >> 1;
+        for (; j & bit; bit >>= 1)
+        {
+            j ^= bit;
+        }
+        j ^= bit;
+
+        if (i < j)
+        {
+            float t = re[i];
+            re[i] = re[j];
+            re[j] = t;
+            t = im[i];
+            im[i] = im[j];
+            im[j] = t;
+        }
+    }
+
+    // Butterfly stages, each twiddle is loaded once per stage
+    for (int len = 2; len <= N; len <<= 1)
+    {
+        int half = len >> 1;
+        int step = (N / len) * stride;
+
+        for (int j = 0; j < half; j++)
+        {
+            float wr = twiddleCos[j * step];
+            float wi = twiddleSin[j * step];
+
+            for (int a = j; a < N; a += len)
+            {
+                int b = a + half;
+                float tr = re[b] * wr - im[b] * wi;
+                float ti = re[b] * wi + im[b] * wr;
+
+                re[b] = re[a] - tr;
+                im[b] = im[a] - ti;
+                re[a] += tr;
+                im[a] += ti;
+            }
+        }
+    }
+}
+
+/*
+re = Real part of the signal, overwritten with the real part of the spectrum
+im = Imaginary part of the signal, overwritten with the imaginary part of the spectrum
+N = Number of points, must be a power of two no larger than FFT_MAX_POINTS
+
+In-place iterative radix-2 decimation-in-time FFT
+*/
+void fft(float *re, float *im, int N)
+{
+    fftCore(re, im, N, buildTwiddles(N));
+}
+
+/*
+x = The input signal
+size = Number of points in the signal
+N = Number of dft points
+power = Power spectrum of DFT, only the N / 2 + 1 unique bins are written
+
+Real-input transform: the N samples are packed as an N / 2 point complex
+FFT and the two interleaved spectra are separated by a post-twiddle pass
+*/
+void rdft(float *x, int size, int N, float *power)
+{
+    if (!isPowerOfTwo(N) || N < 2 || N > FFT_MAX_POINTS)
+    {
+        directDft(x, size, N, N / 2 + 1, power);
+        return;
+    }
+
+    int M = N / 2;
+
+    // Even samples go to the real part, odd samples to the imaginary part.
+    // Samples past N wrap around, matching the direct sum.
+    for (int n = 0; n < M; n++)
+    {
+        workReal[n] = 0.0f;
+        workImag[n] = 0.0f;
+    }
+    for (int n = 0; n < size; n++)
+    {
+        int i = n & (N - 1);
+        if (i & 1)
+        {
+            workImag[i >> 1] += x[n];
+        }
+        else
+        {
+            workReal[i >> 1] += x[n];
+        }
+    }
+
+    // The table is built for N so the post-twiddles below share it
+    int stride = buildTwiddles(N);
+    fftCore(workReal, workImag, M, stride * 2);
+
+    realPowerSpectrum(workReal, workImag, M, twiddleCos, twiddleSin, stride, (float)size, power);
+}
+
+/*
+x = The input signal
+size = Number of points in the signal
+N = Number of dft points
+power = Power spectrum of DFT
+*/
+void dft(float *x, int size, int N, float *power)
+{
+    rdft(x, size, N, power);
+
+    // Upper bins mirror the lower half for real input
+    for (int k = N / 2 + 1; k < N; k++)
+    {
+        power[k] = power[N - k];
+    }
+}
@@ -1,6 +1,10 @@
 #ifndef DFT_H
 #define DFT_H
 
+#define FFT_MAX_POINTS 1024 // Largest transform length served by the FFT path
+
 void dft(float *x, int size, int N, float *power);
+void rdft(float *x, int size, int N, float *power);
+void fft(float *re, float *im, int N);
 
 #endif /* DFT_H */
\ No newline at end of file
@@ -61,6 +61,7 @@
 /** @defgroup L3GD20_Private_Defines
   * @{
   */
+#define L3GD20_CTRL_REG_COUNT      5  /* CTRL_REG1 to CTRL_REG5 */
 
 /**
   * @}
@@ -94,6 +95,14 @@ GYRO_DrvTypeDef L3gd20Drv =
   L3GD20_ReadXYZAngRate
 };
 
+/* Shadow copies of CTRL_REG1 to CTRL_REG5, so the setters and the sample
+   reads never have to fetch the configuration over the bus */
+static uint8_t L3GD20_CtrlReg[L3GD20_CTRL_REG_COUNT] = {0};
+static uint8_t L3GD20_CtrlRegValid = 0;
+
+/* Sensitivity for the full scale held in the CTRL_REG4 shadow [mdps/LSB] */
+static float L3GD20_Sensitivity = L3GD20_SENSITIVITY_250DPS;
+
 /**
   * @}
   */
@@ -101,6 +110,10 @@ GYRO_DrvTypeDef L3gd20Drv =
 /** @defgroup L3GD20_Private_FunctionPrototypes
   * @{
   */
+static void L3GD20_LoadCtrlRegs(void);
+static void L3GD20_WriteCtrlReg(uint8_t RegAddr, uint8_t Value);
+static uint8_t L3GD20_GetCtrlReg(uint8_t RegAddr);
+static void L3GD20_UpdateSensitivity(void);
 
 /**
   * @}
@@ -123,13 +136,16 @@ void L3GD20_Init(uint16_t InitStruct)
   /* Configure the low level interface */
   GYRO_IO_Init();
   
+  /* Fetch the registers Init does not set, once, in a single burst */
+  L3GD20_LoadCtrlRegs();
+  
   /* Write value to MEMS CTRL_REG1 register */
   ctrl = (uint8_t) InitStruct;
-  GYRO_IO_Write(&ctrl, L3GD20_CTRL_REG1_ADDR, 1);
+  L3GD20_WriteCtrlReg(L3GD20_CTRL_REG1_ADDR, ctrl);
   
   /* Write value to MEMS CTRL_REG4 register */  
   ctrl = (uint8_t) (InitStruct >> 8);
-  GYRO_IO_Write(&ctrl, L3GD20_CTRL_REG4_ADDR, 1);
+  L3GD20_WriteCtrlReg(L3GD20_CTRL_REG4_ADDR, ctrl);
 }
 
 
@@ -171,13 +187,14 @@ void L3GD20_RebootCmd(void)
 {
   uint8_t tmpreg;
   
-  /* Read CTRL_REG5 register */
-  GYRO_IO_Read(&tmpreg, L3GD20_CTRL_REG5_ADDR, 1);
+  /* Get CTRL_REG5 register */
+  tmpreg = L3GD20_GetCtrlReg(L3GD20_CTRL_REG5_ADDR);
   
   /* Enable or Disable the reboot memory */
   tmpreg |= L3GD20_BOOT_REBOOTMEMORY;
   
-  /* Write value to MEMS CTRL_REG5 register */
+  /* Write value to MEMS CTRL_REG5 register. BOOT clears itself, so it is
+     left out of the shadow copy */
   GYRO_IO_Write(&tmpreg, L3GD20_CTRL_REG5_ADDR, 1);
 }
 
@@ -192,7 +209,7 @@ void L3GD20_LowPower(uint16_t InitStruct)
 
   /* Write value to MEMS CTRL_REG1 register */
   ctrl = (uint8_t) InitStruct;
-  GYRO_IO_Write(&ctrl, L3GD20_CTRL_REG1_ADDR, 1);
+  L3GD20_WriteCtrlReg(L3GD20_CTRL_REG1_ADDR, ctrl);
 }
 
 /**
@@ -207,8 +224,8 @@ void L3GD20_INT1InterruptConfig(uint16_t Int1Config)
   /* Read INT1_CFG register */
   GYRO_IO_Read(&ctrl_cfr, L3GD20_INT1_CFG_ADDR, 1);
   
-  /* Read CTRL_REG3 register */
-  GYRO_IO_Read(&ctrl3, L3GD20_CTRL_REG3_ADDR, 1);
+  /* Get CTRL_REG3 register */
+  ctrl3 = L3GD20_GetCtrlReg(L3GD20_CTRL_REG3_ADDR);
   
   ctrl_cfr &= 0x80;
   ctrl_cfr |= ((uint8_t) Int1Config >> 8);
@@ -220,7 +237,7 @@ void L3GD20_INT1InterruptConfig(uint16_t Int1Config)
   GYRO_IO_Write(&ctrl_cfr, L3GD20_INT1_CFG_ADDR, 1);
   
   /* Write value to MEMS CTRL_REG3 register */
-  GYRO_IO_Write(&ctrl3, L3GD20_CTRL_REG3_ADDR, 1);
+  L3GD20_WriteCtrlReg(L3GD20_CTRL_REG3_ADDR, ctrl3);
 }
 
 /**
@@ -235,8 +252,8 @@ void L3GD20_EnableIT(uint8_t IntSel)
 {  
   uint8_t tmpreg;
   
-  /* Read CTRL_REG3 register */
-  GYRO_IO_Read(&tmpreg, L3GD20_CTRL_REG3_ADDR, 1);
+  /* Get CTRL_REG3 register */
+  tmpreg = L3GD20_GetCtrlReg(L3GD20_CTRL_REG3_ADDR);
   
   if(IntSel == L3GD20_INT1)
   {
@@ -250,7 +267,7 @@ void L3GD20_EnableIT(uint8_t IntSel)
   }
   
   /* Write value to MEMS CTRL_REG3 register */
-  GYRO_IO_Write(&tmpreg, L3GD20_CTRL_REG3_ADDR, 1);
+  L3GD20_WriteCtrlReg(L3GD20_CTRL_REG3_ADDR, tmpreg);
 }
 
 /**
@@ -265,8 +282,8 @@ void L3GD20_DisableIT(uint8_t IntSel)
 {  
   uint8_t tmpreg;
   
-  /* Read CTRL_REG3 register */
-  GYRO_IO_Read(&tmpreg, L3GD20_CTRL_REG3_ADDR, 1);
+  /* Get CTRL_REG3 register */
+  tmpreg = L3GD20_GetCtrlReg(L3GD20_CTRL_REG3_ADDR);
   
   if(IntSel == L3GD20_INT1)
   {
@@ -280,7 +297,74 @@ void L3GD20_DisableIT(uint8_t IntSel)
   }
   
   /* Write value to MEMS CTRL_REG3 register */
-  GYRO_IO_Write(&tmpreg, L3GD20_CTRL_REG3_ADDR, 1);
+  L3GD20_WriteCtrlReg(L3GD20_CTRL_REG3_ADDR, tmpreg);
+}
+
+/**
+  * @brief  Select the sources routed to INT2
+  * @param  Int2Config: any combination of the INT2 sources
+  *      This parameter can be: 
+  *        @arg L3GD20_INT2INTERRUPT_ENABLE: data ready
+  *        @arg L3GD20_INT2WATERMARK_ENABLE: FIFO watermark
+  *        or 0 to route nothing to INT2
+  * @retval None
+  */
+void L3GD20_INT2InterruptConfig(uint8_t Int2Config)
+{
+  uint8_t tmpreg;
+  
+  /* Get CTRL_REG3 register */
+  tmpreg = L3GD20_GetCtrlReg(L3GD20_CTRL_REG3_ADDR);
+  
+  /* I2_DRDY, I2_WTM, I2_ORun and I2_Empty */
+  tmpreg &= 0xF0;
+  tmpreg |= (Int2Config & 0x0F);
+  
+  /* Write value to MEMS CTRL_REG3 register */
+  L3GD20_WriteCtrlReg(L3GD20_CTRL_REG3_ADDR, tmpreg);
+}
+
+/**
+  * @brief  Set the FIFO mode and watermark
+  * @param  FifoMode: FIFO mode
+  *      This parameter can be: 
+  *        @arg L3GD20_FIFOMODE_BYPASS
+  *        @arg L3GD20_FIFOMODE_FIFO
+  *        @arg L3GD20_FIFOMODE_STREAM
+  * @param  Watermark: FIFO level that raises the watermark interrupt, 0 to 31
+  * @retval None
+  */
+void L3GD20_FIFOConfig(uint8_t FifoMode, uint8_t Watermark)
+{
+  uint8_t tmpreg;
+  
+  tmpreg = FifoMode | (Watermark & L3GD20_FIFO_WATERMARK_MASK);
+  
+  /* Write value to MEMS FIFO_CTRL_REG register */
+  GYRO_IO_Write(&tmpreg, L3GD20_FIFO_CTRL_REG_ADDR, 1);
+}
+
+/**
+  * @brief  Enable or Disable the FIFO
+  * @param  FifoState: new state of the FIFO.
+  *      This parameter can be: 
+  *         @arg: L3GD20_FIFO_DISABLE 
+  *         @arg: L3GD20_FIFO_ENABLE          
+  * @retval None
+  */
+void L3GD20_FIFOCmd(uint8_t FifoState)
+{
+  uint8_t tmpreg;
+  
+  /* Get CTRL_REG5 register */
+  tmpreg = L3GD20_GetCtrlReg(L3GD20_CTRL_REG5_ADDR);
+  
+  tmpreg &= 0xBF;
+  
+  tmpreg |= FifoState;
+  
+  /* Write value to MEMS CTRL_REG5 register */
+  L3GD20_WriteCtrlReg(L3GD20_CTRL_REG5_ADDR, tmpreg);
 }
 
 /**
@@ -292,8 +376,8 @@ void L3GD20_FilterConfig(uint8_t FilterStruct)
 {
   uint8_t tmpreg;
   
-  /* Read CTRL_REG2 register */
-  GYRO_IO_Read(&tmpreg, L3GD20_CTRL_REG2_ADDR, 1);
+  /* Get CTRL_REG2 register */
+  tmpreg = L3GD20_GetCtrlReg(L3GD20_CTRL_REG2_ADDR);
   
   tmpreg &= 0xC0;
   
@@ -301,7 +385,7 @@ void L3GD20_FilterConfig(uint8_t FilterStruct)
   tmpreg |= FilterStruct;
   
   /* Write value to MEMS CTRL_REG2 register */
-  GYRO_IO_Write(&tmpreg, L3GD20_CTRL_REG2_ADDR, 1);
+  L3GD20_WriteCtrlReg(L3GD20_CTRL_REG2_ADDR, tmpreg);
 }
 
 /**
@@ -316,15 +400,15 @@ void L3GD20_FilterCmd(uint8_t HighPassFilterState)
 {
   uint8_t tmpreg;
   
-  /* Read CTRL_REG5 register */
-  GYRO_IO_Read(&tmpreg, L3GD20_CTRL_REG5_ADDR, 1);
+  /* Get CTRL_REG5 register */
+  tmpreg = L3GD20_GetCtrlReg(L3GD20_CTRL_REG5_ADDR);
   
   tmpreg &= 0xEF;
   
   tmpreg |= HighPassFilterState;
   
   /* Write value to MEMS CTRL_REG5 register */
-  GYRO_IO_Write(&tmpreg, L3GD20_CTRL_REG5_ADDR, 1);
+  L3GD20_WriteCtrlReg(L3GD20_CTRL_REG5_ADDR, tmpreg);
 }
 
 /**
@@ -344,57 +428,140 @@ uint8_t L3GD20_GetDataStatus(void)
 
 /**
 * @brief  Calculate the L3GD20 angular data.
+* @note   The data alignment and full scale come from the CTRL_REG4 shadow,
+*         so each call is a single 6-byte burst.
 * @param  pfData: Data out pointer
 * @retval None
 */
 void L3GD20_ReadXYZAngRate(float *pfData)
 {
-  uint8_t tmpbuffer[6] ={0};
   int16_t RawData[3] = {0};
-  uint8_t tmpreg = 0;
-  float sensitivity = 0;
   int i =0;
   
-  GYRO_IO_Read(&tmpreg,L3GD20_CTRL_REG4_ADDR,1);
+  L3GD20_ReadXYZRaw(RawData, 1);
+  
+  /* Multiply by the sensitivity precomputed from CTRL_REG4 */
+  for(i=0; i<3; i++)
+  {
+    pfData[i]=(float)(RawData[i] * L3GD20_Sensitivity);
+  }
+}
+
+/**
+* @brief  Read raw L3GD20 angular data in one burst.
+* @note   With the FIFO enabled the read address wraps from OUT_Z_H back to
+*         OUT_X_L, so NumSamples consecutive samples come out of a single
+*         burst. Without the FIFO only NumSamples = 1 is meaningful.
+* @param  pData: Receives NumSamples X, Y, Z triples in LSB, multiply by
+*         L3GD20_GetSensitivity() for mdps
+* @param  NumSamples: Number of samples to read
+* @retval None
+*/
+void L3GD20_ReadXYZRaw(int16_t *pData, uint16_t NumSamples)
+{
+  uint16_t i = 0;
   
-  GYRO_IO_Read(tmpbuffer,L3GD20_OUT_X_L_ADDR,6);
+  /* The samples land in place, the MCU is little-endian like the default
+     sensor output */
+  GYRO_IO_Read((uint8_t *)pData, L3GD20_OUT_X_L_ADDR, (uint16_t)(6 * NumSamples));
   
-  /* check in the control register 4 the data alignment (Big Endian or Little Endian)*/
-  if(!(tmpreg & L3GD20_BLE_MSB))
+  /* check in the control register 4 shadow the data alignment (Big Endian or Little Endian)*/
+  if(L3GD20_GetCtrlReg(L3GD20_CTRL_REG4_ADDR) & L3GD20_BLE_MSB)
   {
-    for(i=0; i<3; i++)
+    for(i=0; i<3 * NumSamples; i++)
     {
-      RawData[i]=(int16_t)(((uint16_t)tmpbuffer[2*i+1] << 8) + tmpbuffer[2*i]);
+      pData[i]=(int16_t)(((uint16_t)pData[i] << 8) | ((uint16_t)pData[i] >> 8));
     }
   }
-  else
+}
+
+/**
+* @brief  Get the L3GD20 sensitivity for the configured full scale.
+* @param  None
+* @retval Sensitivity in mdps/LSB
+*/
+float L3GD20_GetSensitivity(void)
+{
+  /* Make sure the shadow, and the sensitivity derived from it, are loaded */
+  L3GD20_GetCtrlReg(L3GD20_CTRL_REG4_ADDR);
+  
+  return L3GD20_Sensitivity;
+}
+
+/**
+* @brief  Read CTRL_REG1 to CTRL_REG5 into their shadow copies in one burst.
+* @param  None
+* @retval None
+*/
+static void L3GD20_LoadCtrlRegs(void)
+{
+  GYRO_IO_Read(L3GD20_CtrlReg, L3GD20_CTRL_REG1_ADDR, L3GD20_CTRL_REG_COUNT);
+  
+  /* BOOT clears itself once the reboot is done */
+  L3GD20_CtrlReg[L3GD20_CTRL_REG5_ADDR - L3GD20_CTRL_REG1_ADDR] &= (uint8_t)~L3GD20_BOOT_REBOOTMEMORY;
+  L3GD20_CtrlRegValid = 1;
+  
+  L3GD20_UpdateSensitivity();
+}
+
+/**
+* @brief  Get the shadow copy of a control register.
+* @param  RegAddr: L3GD20_CTRL_REG1_ADDR to L3GD20_CTRL_REG5_ADDR
+* @retval Register value
+*/
+static uint8_t L3GD20_GetCtrlReg(uint8_t RegAddr)
+{
+  /* Registers never written through this driver are fetched once */
+  if(!L3GD20_CtrlRegValid)
   {
-    for(i=0; i<3; i++)
-    {
-      RawData[i]=(int16_t)(((uint16_t)tmpbuffer[2*i] << 8) + tmpbuffer[2*i+1]);
-    }
+    L3GD20_LoadCtrlRegs();
+  }
+  
+  return L3GD20_CtrlReg[RegAddr - L3GD20_CTRL_REG1_ADDR];
+}
+
+/**
+* @brief  Write a control register and keep its shadow copy in step.
+* @param  RegAddr: L3GD20_CTRL_REG1_ADDR to L3GD20_CTRL_REG5_ADDR
+* @param  Value: Value to write
+* @retval None
+*/
+static void L3GD20_WriteCtrlReg(uint8_t RegAddr, uint8_t Value)
+{
+  GYRO_IO_Write(&Value, RegAddr, 1);
+  L3GD20_CtrlReg[RegAddr - L3GD20_CTRL_REG1_ADDR] = Value;
+  
+  if(RegAddr == L3GD20_CTRL_REG4_ADDR)
+  {
+    L3GD20_UpdateSensitivity();
   }
+}
+
+/**
+* @brief  Derive the sensitivity from the CTRL_REG4 shadow.
+* @param  None
+* @retval None
+*/
+static void L3GD20_UpdateSensitivity(void)
+{
+  uint8_t tmpreg = L3GD20_CtrlReg[L3GD20_CTRL_REG4_ADDR - L3GD20_CTRL_REG1_ADDR];
   
   /* Switch the sensitivity value set in the CRTL4 */
   switch(tmpreg & L3GD20_FULLSCALE_SELECTION)
   {
   case L3GD20_FULLSCALE_250:
-    sensitivity=L3GD20_SENSITIVITY_250DPS;
+    L3GD20_Sensitivity=L3GD20_SENSITIVITY_250DPS;
     break;
     
   case L3GD20_FULLSCALE_500:
-    sensitivity=L3GD20_SENSITIVITY_500DPS;
+    L3GD20_Sensitivity=L3GD20_SENSITIVITY_500DPS;
     break;
     
-  case L3GD20_FULLSCALE_2000:
-    sensitivity=L3GD20_SENSITIVITY_2000DPS;
+  default:
+    /* FS = 10 and FS = 11 both select 2000 dps */
+    L3GD20_Sensitivity=L3GD20_SENSITIVITY_2000DPS;
     break;
   }
-  /* Divide by sensitivity */
-  for(i=0; i<3; i++)
-  {
-    pfData[i]=(float)(RawData[i] * sensitivity);
-  }
 }
 
 /**
@@ -220,6 +220,35 @@
   * @}
   */
 
+/** @defgroup INT2_Watermark_Interrupt_status
+  * @{
+  */
+#define L3GD20_INT2WATERMARK_DISABLE       ((uint8_t)0x00)
+#define L3GD20_INT2WATERMARK_ENABLE        ((uint8_t)0x04)
+/**
+  * @}
+  */
+
+/** @defgroup FIFO_status
+  * @{
+  */
+#define L3GD20_FIFO_DISABLE                ((uint8_t)0x00)
+#define L3GD20_FIFO_ENABLE                 ((uint8_t)0x40)
+/**
+  * @}
+  */
+
+/** @defgroup FIFO_Mode_selection
+  * @{
+  */
+#define L3GD20_FIFOMODE_BYPASS             ((uint8_t)0x00)  /*!< Also empties the FIFO */
+#define L3GD20_FIFOMODE_FIFO               ((uint8_t)0x20)
+#define L3GD20_FIFOMODE_STREAM             ((uint8_t)0x40)
+#define L3GD20_FIFO_WATERMARK_MASK         ((uint8_t)0x1F)
+/**
+  * @}
+  */
+
 /** @defgroup INT1_Interrupt_ActiveEdge 
   * @{
   */   
@@ -283,6 +312,11 @@ void    L3GD20_RebootCmd(void);
 void    L3GD20_INT1InterruptConfig(uint16_t Int1Config);
 void    L3GD20_EnableIT(uint8_t IntSel);
 void    L3GD20_DisableIT(uint8_t IntSel);
+void    L3GD20_INT2InterruptConfig(uint8_t Int2Config);
+
+/* FIFO Configuration Functions */
+void    L3GD20_FIFOConfig(uint8_t FifoMode, uint8_t Watermark);
+void    L3GD20_FIFOCmd(uint8_t FifoState);
 
 /* High Pass Filter Configuration Functions */
 void    L3GD20_FilterConfig(uint8_t FilterStruct);
@@ -290,6 +324,10 @@ void    L3GD20_FilterCmd(uint8_t HighPassFilterState);
 void    L3GD20_ReadXYZAngRate(float *pfData);
 uint8_t L3GD20_GetDataStatus(void);
 
+/* Raw Data Functions */
+void    L3GD20_ReadXYZRaw(int16_t *pData, uint16_t NumSamples);
+float   L3GD20_GetSensitivity(void);
+
 /* Gyroscope IO functions */
 void    GYRO_IO_Init(void);
 void    GYRO_IO_DeInit(void);
@@ -109,6 +109,9 @@ uint32_t SpixTimeout = SPIx_TIMEOUT_MAX; /*<! Value of Timeout when SPI communic
 I2C_HandleTypeDef EEP_I2cHandle;
 static SPI_HandleTypeDef SpiHandle;
 static uint8_t Is_LCD_IO_Initialized = 0;
+static DMA_HandleTypeDef GyroDmaTxHandle;
+static DMA_HandleTypeDef GyroDmaRxHandle;
+static uint8_t GyroDmaDummyByte = DUMMY_BYTE;
 
 /**
   * @}
@@ -162,6 +165,9 @@ void                      IOE_WriteMultiple(uint8_t Addr, uint8_t Reg, uint8_t *
 void                      GYRO_IO_Init(void);
 void                      GYRO_IO_Write(uint8_t* pBuffer, uint8_t WriteAddr, uint16_t NumByteToWrite);
 void                      GYRO_IO_Read(uint8_t* pBuffer, uint8_t ReadAddr, uint16_t NumByteToRead);
+static void               GYRO_IO_DMARxCplt(DMA_HandleTypeDef *hdma);
+static void               GYRO_IO_DMARxError(DMA_HandleTypeDef *hdma);
+static void               GYRO_SPIx_DMA_RX_IRQHandler(void);
 
 #ifdef EE_M24LR64
 /* Link function for I2C EEPROM peripheral */
@@ -1080,6 +1086,169 @@ void GYRO_IO_Read(uint8_t* pBuffer, uint8_t ReadAddr, uint16_t NumByteToRead)
 }  
 
 
+/**
+  * @brief  Configures the DMA streams used for Gyroscope burst reads.
+  * @note   GYRO_IO_Init() must have been called first.
+  */
+void GYRO_IO_DMAInit(void)
+{
+  GYRO_SPIx_DMA_CLK_ENABLE();
+
+  /* The TX stream only clocks the bus, it sends the same dummy byte over and over */
+  GyroDmaTxHandle.Instance                 = GYRO_SPIx_DMA_STREAM_TX;
+  GyroDmaTxHandle.Init.Channel             = GYRO_SPIx_DMA_CHANNEL;
+  GyroDmaTxHandle.Init.Direction           = DMA_MEMORY_TO_PERIPH;
+  GyroDmaTxHandle.Init.PeriphInc           = DMA_PINC_DISABLE;
+  GyroDmaTxHandle.Init.MemInc              = DMA_MINC_DISABLE;
+  GyroDmaTxHandle.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+  GyroDmaTxHandle.Init.MemDataAlignment    = DMA_MDATAALIGN_BYTE;
+  GyroDmaTxHandle.Init.Mode                = DMA_NORMAL;
+  GyroDmaTxHandle.Init.Priority            = DMA_PRIORITY_HIGH;
+  GyroDmaTxHandle.Init.FIFOMode            = DMA_FIFOMODE_DISABLE;
+  GyroDmaTxHandle.Init.FIFOThreshold       = DMA_FIFO_THRESHOLD_FULL;
+  GyroDmaTxHandle.Init.MemBurst            = DMA_MBURST_SINGLE;
+  GyroDmaTxHandle.Init.PeriphBurst         = DMA_PBURST_SINGLE;
+  HAL_DMA_Init(&GyroDmaTxHandle);
+
+  /* The RX stream lands the data bytes straight in the caller's buffer */
+  GyroDmaRxHandle.Instance                 = GYRO_SPIx_DMA_STREAM_RX;
+  GyroDmaRxHandle.Init.Channel             = GYRO_SPIx_DMA_CHANNEL;
+  GyroDmaRxHandle.Init.Direction           = DMA_PERIPH_TO_MEMORY;
+  GyroDmaRxHandle.Init.PeriphInc           = DMA_PINC_DISABLE;
+  GyroDmaRxHandle.Init.MemInc              = DMA_MINC_ENABLE;
+  GyroDmaRxHandle.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+  GyroDmaRxHandle.Init.MemDataAlignment    = DMA_MDATAALIGN_BYTE;
+  GyroDmaRxHandle.Init.Mode                = DMA_NORMAL;
+  GyroDmaRxHandle.Init.Priority            = DMA_PRIORITY_VERY_HIGH;
+  GyroDmaRxHandle.Init.FIFOMode            = DMA_FIFOMODE_DISABLE;
+  GyroDmaRxHandle.Init.FIFOThreshold       = DMA_FIFO_THRESHOLD_FULL;
+  GyroDmaRxHandle.Init.MemBurst            = DMA_MBURST_SINGLE;
+  GyroDmaRxHandle.Init.PeriphBurst         = DMA_PBURST_SINGLE;
+  HAL_DMA_Init(&GyroDmaRxHandle);
+
+  GyroDmaRxHandle.XferCpltCallback  = GYRO_IO_DMARxCplt;
+  GyroDmaRxHandle.XferErrorCallback = GYRO_IO_DMARxError;
+
+  // Added for mbed
+  IRQn_Type irqn = (IRQn_Type)(GYRO_SPIx_DMA_RX_IRQn);
+  NVIC_ClearPendingIRQ(irqn);
+  NVIC_DisableIRQ(irqn);
+  NVIC_SetPriority(irqn, GYRO_SPIx_DMA_PREPRIO);
+  NVIC_SetVector(irqn, (uint32_t)GYRO_SPIx_DMA_RX_IRQHandler);
+  NVIC_EnableIRQ(irqn);
+}
+
+/**
+  * @brief  Starts a block read from the Gyroscope through DMA.
+  * @note   Only the address byte goes through the CPU. Chip select is released
+  *         and GYRO_IO_ReadDMACpltCallback() is called from the DMA interrupt
+  *         once the last byte has landed, GYRO_IO_ReadDMAErrorCallback() on a
+  *         DMA error. The bus must not be used until then.
+  * @param  pBuffer: Pointer to the buffer that receives the data read from the Gyroscope.
+  * @param  ReadAddr: Gyroscope's internal address to read from.
+  * @param  NumByteToRead: Number of bytes to read from the Gyroscope.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef GYRO_IO_ReadDMA(uint8_t* pBuffer, uint8_t ReadAddr, uint16_t NumByteToRead)
+{
+  HAL_StatusTypeDef status;
+
+  if(NumByteToRead > 0x01)
+  {
+    ReadAddr |= (uint8_t)(READWRITE_CMD | MULTIPLEBYTE_CMD);
+  }
+  else
+  {
+    ReadAddr |= (uint8_t)READWRITE_CMD;
+  }
+  /* Set chip select Low at the start of the transmission */
+  GYRO_CS_LOW();
+
+  /* Send the Address of the indexed register */
+  SPIx_WriteRead(ReadAddr);
+
+  /* RX requests are enabled before TX ones so no received byte is missed */
+  status = HAL_DMA_Start_IT(&GyroDmaRxHandle, (uint32_t)&SpiHandle.Instance->DR, (uint32_t)pBuffer, NumByteToRead);
+  if(status == HAL_OK)
+  {
+    status = HAL_DMA_Start(&GyroDmaTxHandle, (uint32_t)&GyroDmaDummyByte, (uint32_t)&SpiHandle.Instance->DR, NumByteToRead);
+    if(status != HAL_OK)
+    {
+      HAL_DMA_Abort(&GyroDmaRxHandle);
+    }
+  }
+
+  if(status != HAL_OK)
+  {
+    GYRO_CS_HIGH();
+    return status;
+  }
+
+  SET_BIT(SpiHandle.Instance->CR2, SPI_CR2_RXDMAEN);
+  SET_BIT(SpiHandle.Instance->CR2, SPI_CR2_TXDMAEN);
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Gyroscope DMA block read complete callback.
+  * @note   Called from interrupt context, the application overrides it.
+  */
+__weak void GYRO_IO_ReadDMACpltCallback(void)
+{
+}
+
+/**
+  * @brief  Gyroscope DMA block read error callback.
+  * @note   Called from interrupt context, the application overrides it.
+  */
+__weak void GYRO_IO_ReadDMAErrorCallback(void)
+{
+}
+
+/**
+  * @brief  Ends a Gyroscope DMA block read once the RX stream is done.
+  * @param  hdma: DMA handle
+  */
+static void GYRO_IO_DMARxCplt(DMA_HandleTypeDef *hdma)
+{
+  CLEAR_BIT(SpiHandle.Instance->CR2, SPI_CR2_TXDMAEN | SPI_CR2_RXDMAEN);
+
+  /* The TX stream finished before the last byte was received, this only
+     returns its handle to the ready state for the next read */
+  HAL_DMA_PollForTransfer(&GyroDmaTxHandle, HAL_DMA_FULL_TRANSFER, SpixTimeout);
+
+  /* Set chip select High at the end of the transmission */
+  GYRO_CS_HIGH();
+
+  GYRO_IO_ReadDMACpltCallback();
+}
+
+/**
+  * @brief  Releases the bus after a failed Gyroscope DMA block read.
+  * @param  hdma: DMA handle
+  */
+static void GYRO_IO_DMARxError(DMA_HandleTypeDef *hdma)
+{
+  CLEAR_BIT(SpiHandle.Instance->CR2, SPI_CR2_TXDMAEN | SPI_CR2_RXDMAEN);
+  HAL_DMA_Abort(&GyroDmaTxHandle);
+  GYRO_CS_HIGH();
+
+  /* Re-Initialize the BUS */
+  SPIx_Error();
+
+  GYRO_IO_ReadDMAErrorCallback();
+}
+
+// Added for mbed
+/**
+  * @brief  This function handles Gyroscope SPI DMA RX interrupt request.
+  */
+static void GYRO_SPIx_DMA_RX_IRQHandler(void)
+{
+  HAL_DMA_IRQHandler(&GyroDmaRxHandle);
+}
+
 #ifdef EE_M24LR64
 
 /******************************** LINK I2C EEPROM *****************************/
@@ -278,6 +278,17 @@ typedef enum
 #define GYRO_INT1_EXTI_IRQn                     EXTI1_IRQn 
 #define GYRO_INT2_PIN                           GPIO_PIN_2                  /* PA.02 */
 #define GYRO_INT2_EXTI_IRQn                     EXTI2_IRQn 
+
+/**
+  * @brief  GYROSCOPE SPI DMA streams (SPI5 on DMA2 channel 2)
+  */
+#define GYRO_SPIx_DMA_CLK_ENABLE()              __HAL_RCC_DMA2_CLK_ENABLE()
+#define GYRO_SPIx_DMA_CHANNEL                   DMA_CHANNEL_2
+#define GYRO_SPIx_DMA_STREAM_TX                 DMA2_Stream4
+#define GYRO_SPIx_DMA_STREAM_RX                 DMA2_Stream3
+#define GYRO_SPIx_DMA_RX_IRQn                   DMA2_Stream3_IRQn
+#define GYRO_SPIx_DMA_RX_IRQHandler             DMA2_Stream3_IRQHandler
+#define GYRO_SPIx_DMA_PREPRIO                   0x0F
 /**
   * @}
   */ 
@@ -324,6 +335,12 @@ void     BSP_LED_Toggle(Led_TypeDef Led);
 void     BSP_PB_Init(Button_TypeDef Button, ButtonMode_TypeDef ButtonMode);
 uint32_t BSP_PB_GetState(Button_TypeDef Button);
 
+/* Gyroscope DMA block reads, on top of the GYRO_IO link functions */
+void              GYRO_IO_DMAInit(void);
+HAL_StatusTypeDef GYRO_IO_ReadDMA(uint8_t* pBuffer, uint8_t ReadAddr, uint16_t NumByteToRead);
+void              GYRO_IO_ReadDMACpltCallback(void);
+void              GYRO_IO_ReadDMAErrorCallback(void);
+
 /**
   * @}
   */ 
@@ -0,0 +1,134 @@
+#ifndef DWT_H
+#define DWT_H
+
+#include <math.h>
+#include <stdint.h>
+
+#include "samplering.h"
+
+/*
+Integer lifting implementation of the reversible CDF 5/3 wavelet. The
+transform runs in place on the last N samples, rounded to integers and reports the
+energy of every detail scale plus the final approximation, all in O(N).
+Scale l (1-based) covers sampleRate / 2^(l+1) to sampleRate / 2^l.
+*/
+template <int N, int Levels>
+class WaveletEnergy
+{
+    static_assert(Levels >= 1 && (N % (1 << Levels)) == 0, "N must be a multiple of 2^Levels");
+
+public:
+    /*
+    hop = Number of samples between analyses
+    */
+    WaveletEnergy(int hop = N / 4)
+        : ring(hop)
+    {
+        reset();
+    }
+
+    void reset()
+    {
+        ring.reset();
+        for (int l = 0; l <= Levels; l++)
+        {
+            scaleEnergy[l] = 0;
+        }
+    }
+
+    /*
+    sample = Newest raw sample
+
+    Returns true when the sample triggered a new analysis
+    */
+    bool push(float sample)
+    {
+        if (!ring.push(sample))
+        {
+            return false;
+        }
+        analyse(ring.window());
+        return true;
+    }
+
+    /*
+    x = N contiguous samples, e.g. the window() of another stage's SampleRing
+    */
+    void analyse(const float *x)
+    {
+        // The lifting stays integer so the transform remains reversible
+        for (int n = 0; n < N; n++)
+        {
+            work[n] = (int32_t)lrintf(x[n]);
+        }
+
+        // Level l works on the approximation left at stride 2^l
+        for (int l = 0; l < Levels; l++)
+        {
+            int stride = 1 << l;
+            int count = N >> l;
+            lift(stride, count);
+
+            int64_t e = 0;
+            for (int i = 1; i < count; i += 2)
+            {
+                int64_t d = work[i * stride];
+                e += d * d;
+            }
+            scaleEnergy[l] = e;
+        }
+
+        int stride = 1 << Levels;
+        int64_t e = 0;
+        for (int i = 0; i < N; i += stride)
+        {
+            int64_t s = work[i];
+            e += s * s;
+        }
+        scaleEnergy[Levels] = e;
+    }
+
+    /*
+    scale = 1 to Levels for the detail scales, Levels + 1 for the approximation
+
+    Returns the summed squared coefficients of that scale from the last analysis
+    */
+    int64_t energy(int scale) const
+    {
+        return scaleEnergy[scale - 1];
+    }
+
+    // All Levels + 1 energies, finest detail scale first
+    const int64_t *energies() const
+    {
+        return scaleEnergy;
+    }
+
+private:
+    // One reversible 5/3 lifting step over count samples at the given stride
+    void lift(int stride, int count)
+    {
+        // Predict: odd samples become details, mirrored at the right edge
+        for (int i = 1; i < count; i += 2)
+        {
+            int32_t left = work[(i - 1) * stride];
+            int32_t right = (i + 1 < count) ? work[(i + 1) * stride] : left;
+            work[i * stride] -= (left + right) >> 1;
+        }
+
+        // Update: even samples become the approximation, mirrored at the left edge
+        for (int i = 0; i < count; i += 2)
+        {
+            int32_t left = (i > 0) ? work[(i - 1) * stride] : work[stride];
+            int32_t right = (i + 1 < count) ? work[(i + 1) * stride] : left;
+            work[i * stride] += (left + right + 2) >> 2;
+        }
+    }
+
+    SampleRing<float, N> ring; // Hops between analyses
+
+    int32_t work[N];
+    int64_t scaleEnergy[Levels + 1];
+};
+
+#endif /* DWT_H */
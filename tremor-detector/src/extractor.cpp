@@ -0,0 +1,182 @@
+#include <math.h>
+
+#include "detection.h"
+#include "extractor.h"
+
+/*
+hop = Number of samples per feature vector
+sampleRate = Sampling rate of the gyro samples
+*/
+FeatureExtractor::FeatureExtractor(int hop, float sampleRate)
+    : hop(hop < 2 ? 2 : hop), sampleRate(sampleRate)
+{
+    reset();
+}
+
+void FeatureExtractor::reset()
+{
+    for (int a = 0; a < 3; a++)
+    {
+        centre[a] = 0.0f;
+        previous[a] = 0.0f;
+    }
+    for (int f = 0; f < FEATURE_COUNT; f++)
+    {
+        values[f] = 0.0f;
+    }
+    havePrevious = false;
+    clearSums();
+}
+
+void FeatureExtractor::clearSums()
+{
+    count = 0;
+    jerkSquares = 0.0f;
+    for (int a = 0; a < 3; a++)
+    {
+        sum[a] = 0.0f;
+        sumSquares[a] = 0.0f;
+        sumCross[a] = 0.0f;
+        crossings[a] = 0;
+    }
+}
+
+/*
+x, y, z = Angular rate of each axis
+
+Returns true when the sample completed a hop and the time-domain features were updated
+*/
+bool FeatureExtractor::push(float x, float y, float z)
+{
+    float v[3] = {x, y, z};
+
+    for (int a = 0; a < 3; a++)
+    {
+        sum[a] += v[a];
+        sumSquares[a] += v[a] * v[a];
+    }
+    sumCross[0] += x * y;
+    sumCross[1] += x * z;
+    sumCross[2] += y * z;
+
+    if (havePrevious)
+    {
+        float jerk = 0.0f;
+        for (int a = 0; a < 3; a++)
+        {
+            float d = v[a] - previous[a];
+            jerk += d * d;
+            if ((v[a] - centre[a]) * (previous[a] - centre[a]) < 0.0f)
+            {
+                crossings[a]++;
+            }
+        }
+        jerkSquares += jerk;
+    }
+
+    for (int a = 0; a < 3; a++)
+    {
+        previous[a] = v[a];
+    }
+    havePrevious = true;
+
+    if (++count < hop)
+    {
+        return false;
+    }
+
+    finishHop();
+    clearSums();
+    return true;
+}
+
+void FeatureExtractor::finishHop()
+{
+    float mean[3], var[3];
+    for (int a = 0; a < 3; a++)
+    {
+        mean[a] = sum[a] / count;
+        var[a] = sumSquares[a] / count - mean[a] * mean[a];
+        var[a] = var[a] > 0.0f ? var[a] : 0.0f;
+
+        values[FEATURE_RMS_X + a] = sqrtf(sumSquares[a] / count);
+        values[FEATURE_ZCR_X + a] = crossings[a] * sampleRate / count;
+        centre[a] = mean[a];
+    }
+
+    // RMS of the derivative of the rate vector
+    values[FEATURE_JERK] = sqrtf(jerkSquares / count) * sampleRate;
+
+    const int pairs[3][2] = {{0, 1}, {0, 2}, {1, 2}};
+    for (int p = 0; p < 3; p++)
+    {
+        int i = pairs[p][0], j = pairs[p][1];
+        float cov = sumCross[p] / count - mean[i] * mean[j];
+        float norm = sqrtf(var[i] * var[j]);
+        values[FEATURE_CORR_XY + p] = norm > 0.0f ? cov / norm : 0.0f;
+    }
+}
+
+/*
+power = Power spectrum, the N / 2 + 1 bins written by rdft()
+size = Number of dft points N used to compute power
+
+Fills the spectral centroid and normalised spectral entropy in a single
+pass over the bins, DC excluded, and the band power ratios of the
+defaultTremorBands table through analyseBands()
+*/
+void FeatureExtractor::spectral(const float *power, int size)
+{
+    int bins = size / 2;
+    float binHz = sampleRate / size;
+
+    float total = 0.0f, weighted = 0.0f, plogp = 0.0f;
+
+    for (int k = 1; k <= bins; k++)
+    {
+        float p = power[k];
+        float f = k * binHz;
+
+        total += p;
+        weighted += f * p;
+        if (p > 0.0f)
+        {
+            plogp += p * logf(p);
+        }
+    }
+
+    // Bands sharing a class add up, so the ratios follow any change to the table
+    BandStats stats[MAX_TREMOR_BANDS];
+    analyseBands(power, size, (int)(sampleRate + 0.5f), defaultTremorBands, defaultTremorBandCount, stats);
+    for (int f = FEATURE_RATIO_VOLUNTARY; f <= FEATURE_RATIO_PHYSIOLOGICAL; f++)
+    {
+        values[f] = 0.0f;
+    }
+    for (int b = 0; b < defaultTremorBandCount && b < MAX_TREMOR_BANDS; b++)
+    {
+        TremorClass label = defaultTremorBands[b].label;
+        if (label >= TREMOR_VOLUNTARY && label <= TREMOR_PHYSIOLOGICAL)
+        {
+            values[FEATURE_RATIO_VOLUNTARY + (label - TREMOR_VOLUNTARY)] += stats[b].relativePower;
+        }
+    }
+
+    if (total <= 0.0f)
+    {
+        values[FEATURE_CENTROID] = 0.0f;
+        values[FEATURE_ENTROPY] = 0.0f;
+        return;
+    }
+
+    // H = -sum(p/T * log(p/T)) = log(T) - sum(p log p) / T, scaled to [0, 1]
+    float entropy = logf(total) - plogp / total;
+
+    values[FEATURE_CENTROID] = weighted / total;
+    values[FEATURE_ENTROPY] = bins > 1 ? entropy / logf((float)bins) : 0.0f;
+}
+
+// Latest feature vector, FEATURE_COUNT values indexed by Feature
+const float *FeatureExtractor::features() const
+{
+    return values;
+}
@@ -0,0 +1,65 @@
+#ifndef EXTRACTOR_H
+#define EXTRACTOR_H
+
+enum Feature
+{
+    FEATURE_RMS_X,
+    FEATURE_RMS_Y,
+    FEATURE_RMS_Z,
+    FEATURE_ZCR_X,
+    FEATURE_ZCR_Y,
+    FEATURE_ZCR_Z,
+    FEATURE_JERK,
+    FEATURE_CORR_XY,
+    FEATURE_CORR_XZ,
+    FEATURE_CORR_YZ,
+    FEATURE_CENTROID,
+    FEATURE_ENTROPY,
+    FEATURE_RATIO_VOLUNTARY, // Band power shares by TremorClass, bands from defaultTremorBands
+    FEATURE_RATIO_REST,
+    FEATURE_RATIO_ESSENTIAL,
+    FEATURE_RATIO_PHYSIOLOGICAL,
+    FEATURE_COUNT
+};
+
+/*
+Streaming feature extractor for tremor classification. Time-domain
+features are accumulated as running sums while samples arrive and are
+finalised once per hop, and the spectral features come from one pass over
+a power spectrum, so no window is ever re-read.
+*/
+class FeatureExtractor
+{
+public:
+    FeatureExtractor(int hop, float sampleRate);
+
+    void reset();
+    bool push(float x, float y, float z);
+    void spectral(const float *power, int size);
+
+    const float *features() const;
+
+private:
+    void clearSums();
+    void finishHop();
+
+    int hop;
+    float sampleRate;
+
+    // Running sums of the current hop
+    int count;
+    float sum[3];
+    float sumSquares[3];
+    float sumCross[3]; // XY, XZ, YZ
+    int crossings[3];
+    float jerkSquares;
+
+    // Mean of the previous hop, the reference for zero crossings
+    float centre[3];
+    float previous[3];
+    bool havePrevious;
+
+    float values[FEATURE_COUNT];
+};
+
+#endif /* EXTRACTOR_H */
@@ -0,0 +1,371 @@
+#ifndef FFT_H
+#define FFT_H
+
+#include <stdint.h>
+#include <type_traits>
+
+/*
+Compile-time versions of the math used to build the FFT tables. They are
+only evaluated by the compiler, so the tables land in flash with no
+startup cost.
+*/
+constexpr double FFT_PI = 3.1415926535897932385;
+
+constexpr double constexprCos(double x)
+{
+    // Reduce to [-pi, pi] so the series converges quickly
+    while (x > FFT_PI)
+    {
+        x -= 2 * FFT_PI;
+    }
+    while (x < -FFT_PI)
+    {
+        x += 2 * FFT_PI;
+    }
+
+    double term = 1.0, sum = 1.0;
+    for (int i = 1; i < 16; i++)
+    {
+        term *= -x * x / ((2 * i - 1) * (2 * i));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr double constexprSin(double x)
+{
+    return constexprCos(x - FFT_PI / 2);
+}
+
+enum WindowType
+{
+    WINDOW_NONE,
+    WINDOW_HANN,
+    WINDOW_HAMMING,
+    WINDOW_BLACKMAN
+};
+
+template <int N>
+struct FftTables
+{
+    float cosine[N / 2];  // Real part of e^(-2*pi*i*k/N)
+    float sine[N / 2];    // Imaginary part of e^(-2*pi*i*k/N)
+    uint16_t bitrev[N];   // Bit-reversed index of every point
+};
+
+template <int N>
+struct WindowTable
+{
+    float coef[N];        // Periodic window coefficients
+    float coherentGain;   // Mean of the coefficients, amplitude gain on a tone
+    float enbw;           // Equivalent noise bandwidth in bins
+};
+
+template <int N>
+constexpr FftTables<N> makeFftTables()
+{
+    FftTables<N> t = {};
+
+    for (int k = 0; k < N / 2; k++)
+    {
+        t.cosine[k] = (float)constexprCos(2 * FFT_PI * k / N);
+        t.sine[k] = (float)-constexprSin(2 * FFT_PI * k / N);
+    }
+
+    int bits = 0;
+    while ((1 << bits) < N)
+    {
+        bits++;
+    }
+    for (int i = 0; i < N; i++)
+    {
+        int r = 0;
+        for (int b = 0; b < bits; b++)
+        {
+            r |= ((i >> b) & 1) << (bits - 1 - b);
+        }
+        t.bitrev[i] = (uint16_t)r;
+    }
+
+    return t;
+}
+
+template <int N>
+constexpr WindowTable<N> makeWindowTable(WindowType type)
+{
+    WindowTable<N> t = {};
+    double sum = 0.0, sumSquares = 0.0;
+
+    for (int n = 0; n < N; n++)
+    {
+        double phase = 2 * FFT_PI * n / N;
+        double w = 1.0;
+        switch (type)
+        {
+        case WINDOW_HANN:
+            w = 0.5 - 0.5 * constexprCos(phase);
+            break;
+        case WINDOW_HAMMING:
+            w = 0.54 - 0.46 * constexprCos(phase);
+            break;
+        case WINDOW_BLACKMAN:
+            w = 0.42 - 0.5 * constexprCos(phase) + 0.08 * constexprCos(2 * phase);
+            break;
+        default:
+            break;
+        }
+
+        t.coef[n] = (float)w;
+        sum += w;
+        sumSquares += w * w;
+    }
+
+    t.coherentGain = (float)(sum / N);
+    t.enbw = (float)(N * sumSquares / (sum * sum));
+    return t;
+}
+
+/*
+re = Real part of the M point FFT of a real signal packed with its even
+     samples in the real part and its odd samples in the imaginary part
+im = Imaginary part of that FFT
+M = Length of the packed FFT, half the length of the real signal
+cosine = Real part of e^(-2*pi*i*k/(2 * M)), entry k * stride for bin k
+sine = Imaginary part of the same twiddles
+stride = Step between the twiddles of consecutive bins
+scale = Divisor of the power, the number of samples transformed
+power = Receives the M + 1 unique power bins of the real signal
+
+Post-twiddle pass shared by every real-input transform, it separates the
+two interleaved sub-spectra and combines them into the full spectrum
+*/
+inline void realPowerSpectrum(const float *re, const float *im, int M,
+                              const float *cosine, const float *sine, int stride,
+                              float scale, float *power)
+{
+    float dc = re[0] + im[0];
+    float nyquist = re[0] - im[0];
+    power[0] = (dc * dc) / scale;
+    power[M] = (nyquist * nyquist) / scale;
+
+    for (int k = 1; k < M; k++)
+    {
+        float zr = re[k], zi = im[k];
+        float cr = re[M - k], ci = -im[M - k];
+
+        // Even and odd sub-spectra
+        float evr = 0.5f * (zr + cr), evi = 0.5f * (zi + ci);
+        float odr = 0.5f * (zi - ci), odi = -0.5f * (zr - cr);
+
+        float wr = cosine[k * stride];
+        float wi = sine[k * stride];
+        float Xreal = evr + (odr * wr - odi * wi);
+        float Ximag = evi + (odr * wi + odi * wr);
+
+        power[k] = ((Xreal * Xreal) + (Ximag * Ximag)) / scale;
+    }
+}
+
+/*
+Radix-2 FFT specialised on its length. Twiddle, bit-reversal and window
+tables are constexpr, and the stage loops have compile-time bounds so the
+compiler can unroll the short early stages. Use dft()/rdft() for lengths
+not known at build time.
+*/
+template <int N>
+class Fft
+{
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "Fft length must be a power of two");
+
+public:
+    static constexpr int size = N;
+    static constexpr int bins = N / 2 + 1;
+
+    /*
+    re = Real part of the signal, overwritten with the real part of the spectrum
+    im = Imaginary part of the signal, overwritten with the imaginary part of the spectrum
+    */
+    static void transform(float *re, float *im)
+    {
+        for (int i = 0; i < N; i++)
+        {
+            int j = tables.bitrev[i];
+            if (i < j)
+            {
+                float t = re[i];
+                re[i] = re[j];
+                re[j] = t;
+                t = im[i];
+                im[i] = im[j];
+                im[j] = t;
+            }
+        }
+
+        transformBitReversed(re, im);
+    }
+
+    // Butterfly stages only, for callers that load their data in bit-reversed order
+    static void transformBitReversed(float *re, float *im)
+    {
+        transformBitReversed<1>(reinterpret_cast<float(*)[N]>(re), reinterpret_cast<float(*)[N]>(im));
+    }
+
+    /*
+    re = Real parts of Channels signals of N points, in bit-reversed order
+    im = Imaginary parts of the same signals
+
+    Runs the butterfly stages of all the signals side by side, so every
+    twiddle factor is loaded once for all of them
+    */
+    template <int Channels>
+    static void transformBitReversed(float (*re)[N], float (*im)[N])
+    {
+        stages<2, Channels>(re, im, std::true_type());
+    }
+
+    /*
+    x = The input signal of N points, N at least 4
+    power = Power spectrum, the N / 2 + 1 unique bins normalised like rdft()
+    window = Window applied to the samples
+
+    The window multiply and the bit-reversal permutation are both folded
+    into the load of the first butterfly stage, so neither costs a pass.
+    */
+    static void powerSpectrum(const float *x, float *power, WindowType window = WINDOW_NONE)
+    {
+        // The packed half-length transform must itself be a valid Fft
+        static_assert(N >= 4, "Fft powerSpectrum length must be at least 4");
+
+        constexpr int M = N / 2;
+
+        // Real-input transform: even samples in the real part, odd in the imaginary
+        if (window == WINDOW_NONE)
+        {
+            for (int n = 0; n < M; n++)
+            {
+                int j = Fft<M>::tables.bitrev[n];
+                workReal[j] = x[2 * n];
+                workImag[j] = x[2 * n + 1];
+            }
+        }
+        else
+        {
+            const float *w = windowTable(window).coef;
+            for (int n = 0; n < M; n++)
+            {
+                int j = Fft<M>::tables.bitrev[n];
+                workReal[j] = x[2 * n] * w[2 * n];
+                workImag[j] = x[2 * n + 1] * w[2 * n + 1];
+            }
+        }
+
+        Fft<M>::transformBitReversed(workReal, workImag);
+
+        realPowerSpectrum(workReal, workImag, M, tables.cosine, tables.sine, 1, N, power);
+    }
+
+    static const WindowTable<N> &windowTable(WindowType window)
+    {
+        switch (window)
+        {
+        case WINDOW_HAMMING:
+            return hamming;
+        case WINDOW_BLACKMAN:
+            return blackman;
+        case WINDOW_HANN:
+            return hann;
+        default:
+            return rectangular;
+        }
+    }
+
+    static const float *window(WindowType window)
+    {
+        return windowTable(window).coef;
+    }
+
+    // Amplitude gain of the window on a pure tone
+    static float coherentGain(WindowType window)
+    {
+        return windowTable(window).coherentGain;
+    }
+
+    // Equivalent noise bandwidth of the window in bins
+    static float enbw(WindowType window)
+    {
+        return windowTable(window).enbw;
+    }
+
+    static constexpr FftTables<N> tables = makeFftTables<N>();
+    static constexpr WindowTable<N> rectangular = makeWindowTable<N>(WINDOW_NONE);
+    static constexpr WindowTable<N> hann = makeWindowTable<N>(WINDOW_HANN);
+    static constexpr WindowTable<N> hamming = makeWindowTable<N>(WINDOW_HAMMING);
+    static constexpr WindowTable<N> blackman = makeWindowTable<N>(WINDOW_BLACKMAN);
+
+private:
+    template <int Len, int Channels>
+    static void stages(float (*re)[N], float (*im)[N], std::true_type)
+    {
+        butterflies<Len, Channels>(re, im);
+        stages<Len * 2, Channels>(re, im, std::integral_constant<bool, (Len * 2 <= N)>());
+    }
+
+    template <int Len, int Channels>
+    static void stages(float (*)[N], float (*)[N], std::false_type)
+    {
+    }
+
+    template <int Len, int Channels>
+    static void butterflies(float (*re)[N], float (*im)[N])
+    {
+        constexpr int half = Len / 2;
+        constexpr int step = N / Len;
+
+        for (int j = 0; j < half; j++)
+        {
+            float wr = tables.cosine[j * step];
+            float wi = tables.sine[j * step];
+
+            for (int a = j; a < N; a += Len)
+            {
+                int b = a + half;
+                for (int c = 0; c < Channels; c++)
+                {
+                    float tr = re[c][b] * wr - im[c][b] * wi;
+                    float ti = re[c][b] * wi + im[c][b] * wr;
+
+                    re[c][b] = re[c][a] - tr;
+                    im[c][b] = im[c][a] - ti;
+                    re[c][a] += tr;
+                    im[c][a] += ti;
+                }
+            }
+        }
+    }
+
+    static float workReal[N / 2];
+    static float workImag[N / 2];
+};
+
+template <int N>
+constexpr FftTables<N> Fft<N>::tables;
+
+template <int N>
+constexpr WindowTable<N> Fft<N>::rectangular;
+
+template <int N>
+constexpr WindowTable<N> Fft<N>::hann;
+
+template <int N>
+constexpr WindowTable<N> Fft<N>::hamming;
+
+template <int N>
+constexpr WindowTable<N> Fft<N>::blackman;
+
+template <int N>
+float Fft<N>::workReal[N / 2];
+
+template <int N>
+float Fft<N>::workImag[N / 2];
+
+#endif /* FFT_H */
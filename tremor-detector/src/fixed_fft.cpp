@@ -0,0 +1,262 @@
+#include "fixed_fft.h"
+#include "fft.h"
+
+/*
+The fixed-point path only uses integer arithmetic and a twiddle table
+built by the compiler, so the firmware and a host build produce
+bit-identical results.
+*/
+
+#define BLOCK_LIMIT 8192 // Largest magnitude allowed into a butterfly stage
+
+struct FixedTwiddles
+{
+    int16_t cosine[FIXED_FFT_MAX_POINTS / 2]; // Q15 real part of e^(-2*pi*i*k/N)
+    int16_t sine[FIXED_FFT_MAX_POINTS / 2];   // Q15 imaginary part of e^(-2*pi*i*k/N)
+};
+
+static constexpr int16_t toQ15(double v)
+{
+    return v >= 1.0 ? 32767 : (int16_t)(v * 32768.0 + (v < 0 ? -0.5 : 0.5));
+}
+
+static constexpr FixedTwiddles makeFixedTwiddles()
+{
+    FixedTwiddles t = {};
+    for (int k = 0; k < FIXED_FFT_MAX_POINTS / 2; k++)
+    {
+        t.cosine[k] = toQ15(constexprCos(2 * FFT_PI * k / FIXED_FFT_MAX_POINTS));
+        t.sine[k] = toQ15(-constexprSin(2 * FFT_PI * k / FIXED_FFT_MAX_POINTS));
+    }
+    return t;
+}
+
+static constexpr FixedTwiddles twiddles = makeFixedTwiddles();
+
+// Packed half-length signal for the real-input transform
+static int16_t workReal[FIXED_FFT_MAX_POINTS / 2];
+static int16_t workImag[FIXED_FFT_MAX_POINTS / 2];
+
+static bool isPowerOfTwo(int n)
+{
+    return n > 0 && (n & (n - 1)) == 0;
+}
+
+static int log2Of(int n)
+{
+    int bits = 0;
+    while ((1 << bits) < n)
+    {
+        bits++;
+    }
+    return bits;
+}
+
+static int32_t absOf(int32_t v)
+{
+    return v < 0 ? -v : v;
+}
+
+/*
+re, im = Block to rescale
+N = Number of points
+maxMag = Largest magnitude in the block
+
+Shifts the block so its largest magnitude lies in [BLOCK_LIMIT / 2, BLOCK_LIMIT)
+and returns the exponent that was added
+*/
+static int normaliseBlock(int16_t *re, int16_t *im, int N, int32_t maxMag)
+{
+    if (maxMag == 0)
+    {
+        return 0;
+    }
+
+    int shift = 0;
+    while ((maxMag >> shift) >= BLOCK_LIMIT)
+    {
+        shift++;
+    }
+    while (shift <= 0 && (maxMag << -shift) < BLOCK_LIMIT / 2)
+    {
+        shift--;
+    }
+
+    if (shift > 0)
+    {
+        for (int i = 0; i < N; i++)
+        {
+            re[i] = (int16_t)(re[i] >> shift);
+            im[i] = (int16_t)(im[i] >> shift);
+        }
+    }
+    else if (shift < 0)
+    {
+        for (int i = 0; i < N; i++)
+        {
+            re[i] = (int16_t)(re[i] * (1 << -shift));
+            im[i] = (int16_t)(im[i] * (1 << -shift));
+        }
+    }
+    return shift;
+}
+
+static int fixedFftCore(int16_t *re, int16_t *im, int N, int stride)
+{
+    // Bit-reversal permutation
+    for (int i = 1, j = 0; i < N; i++)
+    {
+        int bit = N >> 1;
+        for (; j & bit; bit >>= 1)
+        {
+            j ^= bit;
+        }
+        j ^= bit;
+
+        if (i < j)
+        {
+            int16_t t = re[i];
+            re[i] = re[j];
+            re[j] = t;
+            t = im[i];
+            im[i] = im[j];
+            im[j] = t;
+        }
+    }
+
+    int32_t maxMag = 0;
+    for (int i = 0; i < N; i++)
+    {
+        int32_t m = absOf(re[i]) > absOf(im[i]) ? absOf(re[i]) : absOf(im[i]);
+        maxMag = m > maxMag ? m : maxMag;
+    }
+    int exponent = normaliseBlock(re, im, N, maxMag);
+    maxMag = 0; // Now below BLOCK_LIMIT
+
+    for (int len = 2; len <= N; len <<= 1)
+    {
+        // Inputs below BLOCK_LIMIT cannot overflow a Q15 butterfly
+        if (maxMag >= BLOCK_LIMIT)
+        {
+            int shift = 0;
+            while ((maxMag >> shift) >= BLOCK_LIMIT)
+            {
+                shift++;
+            }
+            for (int i = 0; i < N; i++)
+            {
+                re[i] = (int16_t)(re[i] >> shift);
+                im[i] = (int16_t)(im[i] >> shift);
+            }
+            exponent += shift;
+        }
+
+        int half = len >> 1;
+        int step = (N / len) * stride;
+        maxMag = 0;
+
+        for (int j = 0; j < half; j++)
+        {
+            int32_t wr = twiddles.cosine[j * step];
+            int32_t wi = twiddles.sine[j * step];
+
+            for (int a = j; a < N; a += len)
+            {
+                int b = a + half;
+                int32_t tr = (re[b] * wr - im[b] * wi) >> 15;
+                int32_t ti = (re[b] * wi + im[b] * wr) >> 15;
+
+                int32_t br = re[a] - tr, bi = im[a] - ti;
+                int32_t ar = re[a] + tr, ai = im[a] + ti;
+                re[b] = (int16_t)br;
+                im[b] = (int16_t)bi;
+                re[a] = (int16_t)ar;
+                im[a] = (int16_t)ai;
+
+                // Track the block maximum while the outputs are in registers
+                int32_t m = absOf(br) > absOf(bi) ? absOf(br) : absOf(bi);
+                m = absOf(ar) > m ? absOf(ar) : m;
+                m = absOf(ai) > m ? absOf(ai) : m;
+                maxMag = m > maxMag ? m : maxMag;
+            }
+        }
+    }
+
+    return exponent;
+}
+
+/*
+re = Real part of the Q15 signal, overwritten with the real part of the spectrum
+im = Imaginary part of the Q15 signal, overwritten with the imaginary part of the spectrum
+N = Number of points, must be a power of two no larger than FIXED_FFT_MAX_POINTS
+
+Block-floating-point radix-2 FFT. Returns the block exponent e, the true
+spectrum is the output scaled by 2^e. Any other length leaves the signal
+untouched and returns 0.
+*/
+int fixedFft(int16_t *re, int16_t *im, int N)
+{
+    if (!isPowerOfTwo(N) || N > FIXED_FFT_MAX_POINTS)
+    {
+        return 0;
+    }
+
+    return fixedFftCore(re, im, N, FIXED_FFT_MAX_POINTS / N);
+}
+
+/*
+x = The Q15 input signal of N points, e.g. raw gyro samples
+N = Number of dft points, a power of two from 2 to FIXED_FFT_MAX_POINTS
+power = Q31 power spectrum, only the N / 2 + 1 unique bins are written
+
+Returns the exponent e of the power spectrum: power[k] * 2^e equals the
+rdft() power of the same samples. There is no direct fallback like rdft()
+has, any other length clears the bins and returns 0.
+*/
+int rdftFixed(const int16_t *x, int N, int32_t *power)
+{
+    if (!isPowerOfTwo(N) || N < 2 || N > FIXED_FFT_MAX_POINTS)
+    {
+        for (int k = 0; k <= N / 2; k++)
+        {
+            power[k] = 0;
+        }
+        return 0;
+    }
+
+    int M = N / 2;
+    int stride = FIXED_FFT_MAX_POINTS / N;
+
+    for (int n = 0; n < M; n++)
+    {
+        workReal[n] = x[2 * n];
+        workImag[n] = x[2 * n + 1];
+    }
+
+    int exponent = fixedFftCore(workReal, workImag, M, stride * 2);
+
+    // Post-twiddle produces 2 * X[k] in Q31 accumulators
+    int32_t dc = 2 * (workReal[0] + workImag[0]);
+    int32_t nyquist = 2 * (workReal[0] - workImag[0]);
+    power[0] = (int32_t)(((int64_t)dc * dc) >> 5);
+    power[M] = (int32_t)(((int64_t)nyquist * nyquist) >> 5);
+
+    for (int k = 1; k < M; k++)
+    {
+        int32_t zr = workReal[k], zi = workImag[k];
+        int32_t cr = workReal[M - k], ci = -workImag[M - k];
+
+        int32_t evr = zr + cr, evi = zi + ci;
+        int32_t odr = zi - ci, odi = cr - zr;
+
+        int64_t wr = twiddles.cosine[k * stride];
+        int64_t wi = twiddles.sine[k * stride];
+        int32_t Xreal = evr + (int32_t)((odr * wr - odi * wi) >> 15);
+        int32_t Ximag = evi + (int32_t)((odr * wi + odi * wr) >> 15);
+
+        power[k] = (int32_t)(((int64_t)Xreal * Xreal + (int64_t)Ximag * Ximag) >> 5);
+    }
+
+    // (2X)^2 >> 5 against X^2 / N
+    return 2 * exponent - 2 + 5 - log2Of(N);
+}
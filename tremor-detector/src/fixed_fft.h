@@ -0,0 +1,11 @@
+#ifndef FIXED_FFT_H
+#define FIXED_FFT_H
+
+#include <stdint.h>
+
+#define FIXED_FFT_MAX_POINTS 1024 // Largest transform length of the fixed-point path
+
+int fixedFft(int16_t *re, int16_t *im, int N);
+int rdftFixed(const int16_t *x, int N, int32_t *power);
+
+#endif /* FIXED_FFT_H */
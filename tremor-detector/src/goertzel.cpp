@@ -0,0 +1,146 @@
+#include <math.h>
+
+#include "goertzel.h"
+
+#define PI 3.1415926535897932385
+
+/*
+N = Number of points in the sliding window, same as the dft() length it mirrors
+sampleRate = Sampling rate of the incoming signal
+minFreq = Lowest frequency of the band
+maxFreq = Highest frequency of the band
+*/
+GoertzelBank::GoertzelBank(int N, int sampleRate, float minFreq, float maxFreq)
+{
+    if (N > GOERTZEL_MAX_POINTS)
+    {
+        N = GOERTZEL_MAX_POINTS;
+    }
+    this->N = N;
+
+    // Same bin mapping as detectPeakIntensity()
+    minBin = floor((minFreq * N) / (float)sampleRate);
+    int maxBin = ceil((maxFreq * N) / (float)sampleRate);
+    if (maxBin > N / 2)
+    {
+        maxBin = N / 2;
+    }
+    bins = maxBin - minBin + 1;
+    if (bins > GOERTZEL_MAX_BINS)
+    {
+        bins = GOERTZEL_MAX_BINS;
+    }
+    if (bins < 0)
+    {
+        bins = 0;
+    }
+
+    for (int i = 0; i < bins; i++)
+    {
+        rotReal[i] = (float)cos(2 * PI * (minBin + i) / N);
+        rotImag[i] = (float)sin(2 * PI * (minBin + i) / N);
+    }
+
+    reset();
+}
+
+void GoertzelBank::reset()
+{
+    for (int n = 0; n < N; n++)
+    {
+        ring[n] = 0.0f;
+    }
+    for (int i = 0; i < bins; i++)
+    {
+        stateReal[i] = 0.0f;
+        stateImag[i] = 0.0f;
+        shadowReal[i] = 0.0f;
+        shadowImag[i] = 0.0f;
+    }
+    head = 0;
+    count = 0;
+    phase = 0;
+}
+
+/*
+sample = Newest sample of the signal
+
+S[k] = (S[k] + x[n] - x[n - N]) * e^(2*pi*i*k/N)
+*/
+void GoertzelBank::update(float sample)
+{
+    float delta = sample - ring[head];
+    ring[head] = sample;
+    head = (head + 1 == N) ? 0 : head + 1;
+
+    for (int i = 0; i < bins; i++)
+    {
+        float sr = stateReal[i] + delta;
+        float si = stateImag[i];
+        stateReal[i] = sr * rotReal[i] - si * rotImag[i];
+        stateImag[i] = sr * rotImag[i] + si * rotReal[i];
+
+        // The shadow bank started from an empty window, so nothing leaves it
+        sr = shadowReal[i] + sample;
+        si = shadowImag[i];
+        shadowReal[i] = sr * rotReal[i] - si * rotImag[i];
+        shadowImag[i] = sr * rotImag[i] + si * rotReal[i];
+    }
+
+    if (count < N)
+    {
+        count++;
+    }
+
+    // Rounding error in the sliding recursion never decays. After N samples
+    // the shadow holds the same sums with only N steps of error, so it takes
+    // over and starts again.
+    if (++phase == N)
+    {
+        phase = 0;
+        for (int i = 0; i < bins; i++)
+        {
+            stateReal[i] = shadowReal[i];
+            stateImag[i] = shadowImag[i];
+            shadowReal[i] = 0.0f;
+            shadowImag[i] = 0.0f;
+        }
+    }
+}
+
+// True once a full window of samples has been seen
+bool GoertzelBank::ready() const
+{
+    return count >= N;
+}
+
+int GoertzelBank::firstBin() const
+{
+    return minBin;
+}
+
+int GoertzelBank::binCount() const
+{
+    return bins;
+}
+
+/*
+i = Index of the bin relative to firstBin()
+
+Returns the power of the bin normalised the same way as dft()
+*/
+float GoertzelBank::binPower(int i) const
+{
+    return ((stateReal[i] * stateReal[i]) + (stateImag[i] * stateImag[i])) / N;
+}
+
+// Returns the summed power of every tracked bin
+float GoertzelBank::bandPower() const
+{
+    float total = 0.0f;
+    for (int i = 0; i < bins; i++)
+    {
+        total += binPower(i);
+    }
+    return total;
+}
@@ -0,0 +1,47 @@
+#ifndef GOERTZEL_H
+#define GOERTZEL_H
+
+#define GOERTZEL_MAX_POINTS 512 // Longest sliding window
+#define GOERTZEL_MAX_BINS 16    // Most bins a band may cover
+
+/*
+Sliding DFT filter bank over the bins covering one frequency band.
+Every sample updates each tracked bin in O(1), so the band power of the
+last N samples is available after every sample without a block FFT.
+A second bank restarted every N samples replaces the sliding states once
+it covers a full window, which bounds their rounding error without ever
+recomputing the window in one go.
+*/
+class GoertzelBank
+{
+public:
+    GoertzelBank(int N, int sampleRate, float minFreq, float maxFreq);
+
+    void update(float sample);
+    void reset();
+
+    bool ready() const;
+    int firstBin() const;
+    int binCount() const;
+    float binPower(int i) const;
+    float bandPower() const;
+
+private:
+    int N;
+    int minBin;
+    int bins;
+
+    float ring[GOERTZEL_MAX_POINTS];
+    int head;
+    int count;
+    int phase; // Samples the shadow bank has seen since it restarted
+
+    float rotReal[GOERTZEL_MAX_BINS];
+    float rotImag[GOERTZEL_MAX_BINS];
+    float stateReal[GOERTZEL_MAX_BINS];
+    float stateImag[GOERTZEL_MAX_BINS];
+    float shadowReal[GOERTZEL_MAX_BINS];
+    float shadowImag[GOERTZEL_MAX_BINS];
+};
+
+#endif /* GOERTZEL_H */
@@ -0,0 +1,96 @@
+#include <math.h>
+
+#include "hilbert.h"
+
+#define PI 3.1415926535897932385
+
+/*
+taps = Length of the Hilbert transformer, forced odd and at most HILBERT_MAX_TAPS.
+       Longer filters reach lower frequencies at the cost of latency.
+*/
+HilbertEnvelope::HilbertEnvelope(int taps)
+{
+    if (taps > HILBERT_MAX_TAPS)
+    {
+        taps = HILBERT_MAX_TAPS;
+    }
+    if (taps < 3)
+    {
+        taps = 3;
+    }
+    if ((taps & 1) == 0)
+    {
+        taps--;
+    }
+    this->taps = taps;
+    half = taps / 2;
+    line = SampleRing<float, HILBERT_MAX_TAPS>(1, taps);
+
+    // Ideal response 2 / (pi * m) at odd offsets m, tapered by a Hamming window
+    for (int i = 0; i * 2 + 1 <= half; i++)
+    {
+        int m = 2 * i + 1;
+        double w = 0.54 + 0.46 * cos(PI * m / (half + 1));
+        coef[i] = (float)(2.0 / (PI * m) * w);
+    }
+
+    reset();
+}
+
+void HilbertEnvelope::reset()
+{
+    line.reset();
+    re = 0.0f;
+    im = 0.0f;
+}
+
+/*
+sample = Newest sample of the signal, ideally already band-pass filtered
+*/
+void HilbertEnvelope::push(float sample)
+{
+    line.push(sample);
+
+    // Oldest sample first, the centre tap is the matched delay
+    const float *x = line.window();
+    const float *centre = &x[half];
+
+    // Antisymmetric taps: each coefficient serves a pair of samples
+    float acc = 0.0f;
+    for (int i = 0; i * 2 + 1 <= half; i++)
+    {
+        int m = 2 * i + 1;
+        acc += coef[i] * (centre[-m] - centre[m]);
+    }
+
+    re = *centre;
+    im = acc;
+}
+
+// Instantaneous amplitude of the sample latency() samples ago
+float HilbertEnvelope::amplitude() const
+{
+    return sqrtf(re * re + im * im);
+}
+
+// Instantaneous phase in radians of the sample latency() samples ago
+float HilbertEnvelope::phase() const
+{
+    return atan2f(im, re);
+}
+
+float HilbertEnvelope::inPhase() const
+{
+    return re;
+}
+
+float HilbertEnvelope::quadrature() const
+{
+    return im;
+}
+
+// Delay in samples between an input and the analytic signal it produces
+int HilbertEnvelope::latency() const
+{
+    return half;
+}
@@ -0,0 +1,39 @@
+#ifndef HILBERT_H
+#define HILBERT_H
+
+#include "samplering.h"
+
+#define HILBERT_MAX_TAPS 63 // Longest Hilbert transformer
+
+/*
+Streaming analytic signal. An odd-length FIR Hilbert transformer gives the
+quadrature component and a matched delay line gives the in-phase one, so
+amplitude and phase are available every sample, delayed by exactly
+latency() samples and free of the ripple of a rectify-and-average filter.
+*/
+class HilbertEnvelope
+{
+public:
+    HilbertEnvelope(int taps = 31);
+
+    void reset();
+    void push(float sample);
+
+    float amplitude() const;
+    float phase() const;
+    float inPhase() const;
+    float quadrature() const;
+    int latency() const;
+
+private:
+    int taps;
+    int half;
+    float coef[HILBERT_MAX_TAPS / 2 + 1]; // Odd-offset taps, the even ones are zero
+
+    SampleRing<float, HILBERT_MAX_TAPS> line;
+
+    float re;
+    float im;
+};
+
+#endif /* HILBERT_H */
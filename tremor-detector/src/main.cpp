@@ -10,133 +10,192 @@ Jinkai Zhou jz6443
 */ 
 #include <mbed.h>
 #include <drivers/LCD_DISCO_F429ZI.h>
-// Timer for periodic actions
-Ticker periodicTicker;
-volatile int tickCount = 0;
+#include "acquisition.h"
+#include "decimator.h"
+#include "goertzel.h"
+#include "noisefloor.h"
+#include "quantile.h"
+#include "tremor.h"
 LCD_DISCO_F429ZI lcd;  // Create an instance of the LCD class
 
-// Increment the tick counter in a cyclic manner
-void updateTickCount() {
-    tickCount = (tickCount + 1) % 50000;
-}
+// The display is redrawn from main() so a slow Clear() never holds up processing
+#define DISPLAY_UPDATE 1
+EventFlags displayFlags;
+volatile uint32_t screenColour = LCD_COLOR_BLACK;
 
-// Gyroscope configuration settings
-#define GYRO_SETUP_REG1 0x20
-#define SETUP_VALUE_REG1 0b01'10'1'1'1'1
-#define GYRO_SETUP_REG4 0x23
-#define SETUP_VALUE_REG4 0b0'0'01'0'00'0
-#define SPI_TRANSACTION_COMPLETE 1
-#define GYROSCOPE_READ_ADDRESS 0x28
+// Session tremor intensity, snapshotted for the display on every redraw
+volatile int intensityMedian = 0, intensity90 = 0;
 
-EventFlags spiTransactionFlag;
+// Strongest bin of the tremor band in tenths of a Hz, snapshotted with the intensity
+volatile int tremorFrequency = 0;
 
-// Notify when SPI transaction completes
-void onSPIDone(int status) {
-    spiTransactionFlag.set(SPI_TRANSACTION_COMPLETE);
-}
+// Output indicators
+DigitalOut tremorIndicator(LED1, 0), severityIndicator(LED2, 0);
+
+// Gyroscope configuration settings
+#define SETUP_VALUE_REG1 0b00'10'1'1'1'1  // 95 Hz ODR, 25 Hz bandwidth, all axes on
+#define SETUP_VALUE_REG4 0b0'0'01'0'00'0
+#define GYRO_BATCH 20        // Samples per processing wakeup, under five a second
+#define GYRO_DECIMATION 5    // 95 Hz down to the 19 Hz the tremor filter is designed for
+#define SAMPLE_RATE (95 / GYRO_DECIMATION)
 
 #define CONVERSION_FACTOR (0.0174533f)  // Radians per degree
 
-int main() {
-    lcd.Init();  // Initialize the LCD
-    lcd.Clear(LCD_COLOR_BLACK);  // Clear the LCD with a black background
-    // Output indicators
-    DigitalOut tremorIndicator(LED1, 0), severityIndicator(LED2, 0);
+// Adaptive tremor thresholds relative to the tracked noise floor
+#define NOISE_SUBWINDOW 285      // Processed samples per subwindow, 15s, 8 of them span 2 minutes
+// The quiet-floor thresholds are where the earlier rectified average crossed 5 and 20,
+// measured on simulated 4 and 5 Hz tremors through the whole chain, see test_tremor
+#define MIN_NOISE_FLOOR 14.0f    // Floor assumed while the tracked one is lower
+#define TREMOR_SNR 4.0f          // Tremor above 4x the floor (56 on a quiet floor)
+#define SEVERE_SNR 5.8f          // Severe tremor above 5.8x the floor (81 on a quiet floor)
 
-    // SPI interface configuration
-    SPI spiInterface(PF_9, PF_8, PF_7, PC_1, use_gpio_ssel);
-    periodicTicker.attach(&updateTickCount, 0.01);  // Tick every 10ms
+int16_t tremorCount = 0;
 
-    uint8_t spiOutputBuffer[32], spiInputBuffer[32];
-    uint8_t isSteady;
+// Band-pass and instantaneous amplitude, without the lag and ripple of a rectified average
+TremorFilter tremor;
 
-    // Set SPI parameters
-    spiInterface.format(8, 3);
-    spiInterface.frequency(1000000);
+// The floor tracks the 2 minute minimum of the amplitude itself, so a tremor only
+// becomes the floor once it has lasted the whole window, while a resting baseline
+// above the thresholds is taken up as soon as it is seen
+NoiseFloor<1, 8> noiseFloor(NOISE_SUBWINDOW, 0.0f);
 
-    // Initialize gyroscope
-    spiOutputBuffer[0] = GYRO_SETUP_REG1;
-    spiOutputBuffer[1] = SETUP_VALUE_REG1;
-    spiInterface.transfer(spiOutputBuffer, 2, spiInputBuffer, 2, onSPIDone);
-    spiTransactionFlag.wait_all(SPI_TRANSACTION_COMPLETE);
+// Amplitude of every sample detected as tremor since power on
+QuantileSketch intensity;
 
-    spiOutputBuffer[0] = GYRO_SETUP_REG4;
-    spiOutputBuffer[1] = SETUP_VALUE_REG4;
-    spiInterface.transfer(spiOutputBuffer, 2, spiInputBuffer, 2, onSPIDone);
-    spiTransactionFlag.wait_all(SPI_TRANSACTION_COMPLETE);
+// Sliding DFT over the tremor band, fresh bin powers every sample without a block FFT
+#define BAND_WINDOW 64           // Samples per sliding window, 3.4s and 0.3 Hz bins
+GoertzelBank tremorBand(BAND_WINDOW, SAMPLE_RATE, 3.0f, 6.0f);
 
-    uint16_t startMarker;
+// 1: each data-ready edge on INT2 is timestamped and read by DMA into the sample ring
+// 0: the sensor FIFO gathers GYRO_BATCH samples and DMA drains them in one burst
+#define GYRO_DRDY_CLOCKED 1
 
-    // Digital Signal Processing (DSP) coefficients
-    float feedback[5] = {1.0, -0.482, 0.810, -0.227, 0.272};
-    float forward[5] = {0.131, 0.0, -0.262, 0.0, 0.131};
+#if GYRO_DRDY_CLOCKED
+GyroDrdy gyro(PA_2);
+#else
+GyroDma gyro(PA_2);
+#endif
 
-    float yData[5] = {0};
-    int16_t outputData[5] = {0};
-    int16_t meanAngularY = 0;
-    int16_t tremorCount = 0;
+// Anti-aliased rate reduction, one chain per axis
+Decimator<GYRO_DECIMATION> decimatorX, decimatorY, decimatorZ;
+GyroSample batch[GYRO_RING_SIZE];
 
-    while(true) {
-        uint16_t sensorDataX, sensorDataY, sensorDataZ;
-        int16_t velX, velY, velZ;
-        startMarker = tickCount;
-
-        // Read data from gyroscope
-        spiOutputBuffer[0] = GYROSCOPE_READ_ADDRESS | 0x80 | 0x40;
-        spiInterface.transfer(spiOutputBuffer, 7, spiInputBuffer, 7, onSPIDone);
-        spiTransactionFlag.wait_all(SPI_TRANSACTION_COMPLETE);
-
-        // Parse the SPI data into raw sensor readings
-        sensorDataX = (((uint16_t)spiInputBuffer[2]) << 8) | ((uint16_t)spiInputBuffer[1]);
-        sensorDataY = (((uint16_t)spiInputBuffer[4]) << 8) | ((uint16_t)spiInputBuffer[3]);
-        sensorDataZ = (((uint16_t)spiInputBuffer[6]) << 8) | ((uint16_t)spiInputBuffer[5]);
-
-        // Calculate angular velocities
-        velX = ((int16_t)sensorDataX) * CONVERSION_FACTOR;
-        velY = ((int16_t)sensorDataY) * CONVERSION_FACTOR;
-        velZ = ((int16_t)sensorDataZ) * CONVERSION_FACTOR;
-
-        // Update buffer for DSP
-        for (int i = 4; i > 0; --i) {
-            yData[i] = yData[i - 1];
-            outputData[i] = outputData[i - 1];
-        }
-        yData[0] = velY;
+Thread processingThread(osPriorityAboveNormal);
+
+// Frequency of the strongest tremor band bin in tenths of a Hz, 0 until the window is full
+int bandFrequency() {
+    if (!tremorBand.ready()) {
+        return 0;
+    }
 
-        // Apply DSP to filter the signal
-        outputData[0] = forward[0] * yData[0];
-        for (int i = 1; i < 5; ++i) {
-            outputData[0] += int16_t(forward[i] * yData[i] - feedback[i] * outputData[i]);
+    int strongest = 0;
+    for (int i = 1; i < tremorBand.binCount(); i++) {
+        if (tremorBand.binPower(i) > tremorBand.binPower(strongest)) {
+            strongest = i;
         }
+    }
+    return (tremorBand.firstBin() + strongest) * 10 * SAMPLE_RATE / BAND_WINDOW;
+}
 
-        // Determine tremor stability
-        isSteady = (abs(velX) + abs(velZ) < 50) ? 1 : 0;
-        meanAngularY = int16_t((49 * meanAngularY + isSteady * abs(outputData[0])) / 50);
+// Run the tremor filter and detection on one sample at the decimated rate
+void processSample(int16_t velX, int16_t velY, int16_t velZ) {
+    uint8_t isSteady;
+    uint32_t colour;
+
+    tremorBand.update(velY);
+
+    // Determine tremor stability
+    isSteady = (abs(velX) + abs(velZ) < 50) ? 1 : 0;
+    float level = tremor.push(velY, isSteady);
+    noiseFloor.update(&level);
+    float snr = noiseFloor.snr(0, level, MIN_NOISE_FLOOR);
+
+    // Tremor detection and signaling
+    if (snr > TREMOR_SNR) {
+        intensity.add(level);
+        tremorCount++;
+        tremorIndicator = 1;
+        colour = LCD_COLOR_GREEN;
+    } else {
+        tremorCount = tremorCount < 10 ? 0 : tremorCount - 10;
+        tremorIndicator = 0;
+        colour = LCD_COLOR_BLACK;  // Clear to black when there is no tremor
+    }
 
-        // Tremor detection and signaling
-        if (meanAngularY > 5) {
-            tremorCount++;
-            tremorIndicator = 1;
-            lcd.Clear(LCD_COLOR_GREEN);
+    if (tremorCount > 200) {
+        if (snr > SEVERE_SNR) {
+            severityIndicator = !severityIndicator;  // Toggle the LED for severe tremors
+            colour = LCD_COLOR_RED;
         } else {
-            tremorCount = tremorCount < 10 ? 0 : tremorCount - 10;
-            tremorIndicator = 0;
-            lcd.Clear(LCD_COLOR_BLACK);  // Clear to black when there is no tremor
+            severityIndicator = 1;
+            colour = LCD_COLOR_GREEN;
+        }
+    } else {
+        severityIndicator = 0;
+    }
+
+    if (colour != screenColour) {
+        screenColour = colour;
+        if (intensity.count() > 0) {
+            intensityMedian = int(intensity.quantile(0.5f));
+            intensity90 = int(intensity.quantile(0.9f));
         }
+        tremorFrequency = bandFrequency();
+        displayFlags.set(DISPLAY_UPDATE);
+    }
+}
 
-        if (tremorCount > 200) {
-            if (meanAngularY > 20) {
-                severityIndicator = !severityIndicator;  // Toggle the LED for severe tremors
-                lcd.Clear(LCD_COLOR_RED);
-            } else {
-                severityIndicator = 1;
-                lcd.Clear(LCD_COLOR_GREEN);
+// Consumer side of the sample ring, filtering and detection at the decimated rate
+void processSamples() {
+    while(true) {
+        // Sleeps until a batch has been gathered
+        int count = gyro.read(batch, GYRO_RING_SIZE);
+
+        for (int n = 0; n < count; n++) {
+            float rawX, rawY, rawZ;
+            decimatorX.push(batch[n].x, &rawX);
+            decimatorY.push(batch[n].y, &rawY);
+            if (!decimatorZ.push(batch[n].z, &rawZ)) {
+                continue;
             }
-        } else {
-            severityIndicator = 0;
+
+            // Calculate angular velocities
+            int16_t velX = rawX * CONVERSION_FACTOR;
+            int16_t velY = rawY * CONVERSION_FACTOR;
+            int16_t velZ = rawZ * CONVERSION_FACTOR;
+
+            processSample(velX, velY, velZ);
+        }
+    }
+}
+
+int main() {
+    lcd.Init();  // Initialize the LCD
+    lcd.Clear(LCD_COLOR_BLACK);  // Clear the LCD with a black background
+
+    gyro.start(SETUP_VALUE_REG1, SETUP_VALUE_REG4, GYRO_BATCH);
+    processingThread.start(processSamples);
+
+    char text[32];
+    lcd.SetTextColor(LCD_COLOR_WHITE);
+
+    while(true) {
+        displayFlags.wait_any(DISPLAY_UPDATE);
+        uint32_t colour = screenColour;
+        lcd.Clear(colour);
+
+        // Median and 90th percentile tremor amplitude of the session so far
+        if (intensity90 > 0) {
+            snprintf(text, sizeof(text), "P50 %d  P90 %d", intensityMedian, intensity90);
+            lcd.SetBackColor(colour);
+            lcd.DisplayStringAt(0, LINE(1), (uint8_t *)text, CENTER_MODE);
         }
 
-        // Maintain consistent timing
-        thread_sleep_for(50 - (tickCount - startMarker) % 50000 * 10);
+        // Tremor frequency while one is shown
+        if (colour != LCD_COLOR_BLACK && tremorFrequency > 0) {
+            snprintf(text, sizeof(text), "%d.%d Hz", tremorFrequency / 10, tremorFrequency % 10);
+            lcd.SetBackColor(colour);
+            lcd.DisplayStringAt(0, LINE(2), (uint8_t *)text, CENTER_MODE);
+        }
     }
 }
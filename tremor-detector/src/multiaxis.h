@@ -0,0 +1,106 @@
+#ifndef MULTIAXIS_H
+#define MULTIAXIS_H
+
+#include "fft.h"
+#include "samplering.h"
+
+enum Axis
+{
+    AXIS_X,
+    AXIS_Y,
+    AXIS_Z,
+    AXIS_COUNT
+};
+
+/*
+Spectral analysis of all three gyro axes at once. Samples are kept in one
+planar ring per axis, and the three real-input FFTs run side by side so
+every twiddle factor is loaded once and used for all axes.
+*/
+template <int N>
+class MultiAxisFft
+{
+public:
+    MultiAxisFft(WindowType window = WINDOW_HANN)
+        : window(window)
+    {
+        reset();
+    }
+
+    void reset()
+    {
+        for (int a = 0; a < AXIS_COUNT; a++)
+        {
+            samples[a].reset();
+        }
+    }
+
+    void push(float x, float y, float z)
+    {
+        samples[AXIS_X].push(x);
+        samples[AXIS_Y].push(y);
+        samples[AXIS_Z].push(z);
+    }
+
+    // True once N samples of every axis are buffered
+    bool ready() const
+    {
+        return samples[AXIS_X].full();
+    }
+
+    /*
+    Transforms the last N samples of every axis. Afterwards spectrum() holds
+    the power of each axis and combined() the power summed over the axes,
+    all as N / 2 + 1 bins normalised like rdft().
+    */
+    void analyse()
+    {
+        constexpr int M = N / 2;
+        const float *w = Fft<N>::window(window);
+
+        for (int a = 0; a < AXIS_COUNT; a++)
+        {
+            const float *x = samples[a].window();
+            for (int n = 0; n < M; n++)
+            {
+                int j = Fft<M>::tables.bitrev[n];
+                workReal[a][j] = x[2 * n] * w[2 * n];
+                workImag[a][j] = x[2 * n + 1] * w[2 * n + 1];
+            }
+        }
+
+        Fft<M>::template transformBitReversed<AXIS_COUNT>(workReal, workImag);
+
+        for (int a = 0; a < AXIS_COUNT; a++)
+        {
+            realPowerSpectrum(workReal[a], workImag[a], M, Fft<N>::tables.cosine, Fft<N>::tables.sine, 1, N, power[a]);
+        }
+
+        for (int k = 0; k <= M; k++)
+        {
+            total[k] = power[AXIS_X][k] + power[AXIS_Y][k] + power[AXIS_Z][k];
+        }
+    }
+
+    const float *spectrum(Axis axis) const
+    {
+        return power[axis];
+    }
+
+    const float *combined() const
+    {
+        return total;
+    }
+
+private:
+    WindowType window;
+
+    SampleRing<float, N> samples[AXIS_COUNT];
+
+    float workReal[AXIS_COUNT][N / 2];
+    float workImag[AXIS_COUNT][N / 2];
+    float power[AXIS_COUNT][N / 2 + 1];
+    float total[N / 2 + 1];
+};
+
+#endif /* MULTIAXIS_H */
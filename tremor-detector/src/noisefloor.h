@@ -0,0 +1,171 @@
+#ifndef NOISEFLOOR_H
+#define NOISEFLOOR_H
+
+/*
+Minimum of the last Subwindows * subwindowLength values. Each subwindow
+is reduced to its minimum as it completes, and those minima are kept in a
+monotonic deque, so a push costs O(1) amortised and memory does not grow
+with the window length.
+*/
+template <int Subwindows>
+class SlidingMinimum
+{
+public:
+    SlidingMinimum(int subwindowLength = 1)
+        : length(subwindowLength < 1 ? 1 : subwindowLength)
+    {
+        reset();
+    }
+
+    void reset()
+    {
+        front = 0;
+        count = 0;
+        completed = 0;
+        inCurrent = 0;
+        current = 0.0f;
+    }
+
+    void push(float value)
+    {
+        if (inCurrent == 0 || value < current)
+        {
+            current = value;
+        }
+        if (++inCurrent < length)
+        {
+            return;
+        }
+
+        unsigned long id = completed++;
+
+        // Drop minima of subwindows that slid out
+        while (count > 0 && deque[front].id + Subwindows <= id)
+        {
+            front = slot(1);
+            count--;
+        }
+
+        // Drop minima that can no longer be the smallest
+        while (count > 0 && deque[slot(count - 1)].value >= current)
+        {
+            count--;
+        }
+        deque[slot(count)].value = current;
+        deque[slot(count)].id = id;
+        count++;
+
+        inCurrent = 0;
+    }
+
+    // Minimum over the full window including the subwindow being filled
+    float minimum() const
+    {
+        if (count == 0)
+        {
+            return current;
+        }
+        float m = deque[front].value;
+        return (inCurrent > 0 && current < m) ? current : m;
+    }
+
+private:
+    int slot(int i) const
+    {
+        int s = front + i;
+        return s >= Subwindows ? s - Subwindows : s;
+    }
+
+    struct Entry
+    {
+        float value;
+        unsigned long id;
+    };
+
+    int length;
+    Entry deque[Subwindows];
+    int front;
+    int count;
+    unsigned long completed;
+    int inCurrent;
+    float current;
+};
+
+/*
+Minimum-statistics noise floor for Channels bins or bands. Each channel's
+power is smoothed, its minimum over a sliding window is tracked, and the
+minimum is scaled by a bias factor since the minimum of a fluctuating
+value sits below its mean. Detection can then compare against snr()
+instead of an absolute threshold.
+*/
+template <int Channels, int Subwindows>
+class NoiseFloor
+{
+public:
+    /*
+    subwindowLength = Updates per subwindow, the window spans Subwindows of them
+    smoothing = Weight of the previous smoothed power, 0 disables smoothing
+    bias = Ratio of the mean noise power to its tracked minimum
+    */
+    NoiseFloor(int subwindowLength, float smoothing = 0.8f, float bias = 1.5f)
+        : smoothing(smoothing), bias(bias)
+    {
+        for (int c = 0; c < Channels; c++)
+        {
+            trackers[c] = SlidingMinimum<Subwindows>(subwindowLength);
+        }
+        reset();
+    }
+
+    void reset()
+    {
+        for (int c = 0; c < Channels; c++)
+        {
+            trackers[c].reset();
+            smoothed[c] = 0.0f;
+        }
+        started = false;
+    }
+
+    /*
+    power = One value per channel, e.g. a band power or a spectrum bin
+    */
+    void update(const float *power)
+    {
+        for (int c = 0; c < Channels; c++)
+        {
+            smoothed[c] = started ? smoothing * smoothed[c] + (1.0f - smoothing) * power[c] : power[c];
+            trackers[c].push(smoothed[c]);
+        }
+        started = true;
+    }
+
+    float floor(int channel) const
+    {
+        return bias * trackers[channel].minimum();
+    }
+
+    /*
+    channel = Channel the power belongs to
+    power = Current power of that channel
+    minFloor = Lowest floor to divide by, keeps the ratio finite in silence
+    */
+    float snr(int channel, float power, float minFloor) const
+    {
+        float f = floor(channel);
+        if (f < minFloor)
+        {
+            f = minFloor;
+        }
+        return power / f;
+    }
+
+private:
+    float smoothing;
+    float bias;
+    bool started;
+    float smoothed[Channels];
+    SlidingMinimum<Subwindows> trackers[Channels];
+};
+
+#endif /* NOISEFLOOR_H */
@@ -0,0 +1,180 @@
+#include <math.h>
+
+#include "quantile.h"
+
+#define PI 3.1415926535897932385
+
+// Scale function k(q) = delta / (2 * pi) * asin(2q - 1) spans delta / 2 units.
+// Greedy merging leaves under two centroids per unit, so delta is half the capacity.
+#define COMPRESSION (QUANTILE_MAX_CENTROIDS / 2)
+
+static float scaleK(float q)
+{
+    return (float)(COMPRESSION / (2 * PI)) * asinf(2.0f * q - 1.0f);
+}
+
+QuantileSketch::QuantileSketch()
+{
+    reset();
+}
+
+void QuantileSketch::reset()
+{
+    centroidCount = 0;
+    totalWeight = 0.0;
+    minValue = 0.0f;
+    maxValue = 0.0f;
+}
+
+/*
+value = New observation, e.g. one detector output
+weight = Number of observations it stands for
+*/
+void QuantileSketch::add(float value, float weight)
+{
+    if (centroidCount == 0)
+    {
+        minValue = value;
+        maxValue = value;
+    }
+    minValue = value < minValue ? value : minValue;
+    maxValue = value > maxValue ? value : maxValue;
+
+    Centroid c = {value, weight};
+    compress(&c, 1);
+}
+
+/*
+other = Sketch of another session, left unchanged
+*/
+void QuantileSketch::merge(const QuantileSketch &other)
+{
+    if (other.centroidCount == 0)
+    {
+        return;
+    }
+
+    float lo = minValue, hi = maxValue;
+    bool empty = centroidCount == 0;
+
+    // The other centroids are already sorted, so they fold in as one batch
+    compress(other.centroids, other.centroidCount);
+
+    // Centroid means lie inside the range, the true extremes come from other
+    minValue = (empty || other.minValue < lo) ? other.minValue : lo;
+    maxValue = (empty || other.maxValue > hi) ? other.maxValue : hi;
+}
+
+/*
+incoming = Centroids sorted by mean
+count = Number of incoming centroids, at most QUANTILE_MAX_CENTROIDS
+
+Folds the incoming centroids into the sketch, merging neighbours the scale function allows
+*/
+void QuantileSketch::compress(const Centroid *incoming, int count)
+{
+    Centroid sorted[2 * QUANTILE_MAX_CENTROIDS];
+    int n = 0;
+    int a = 0, b = 0;
+    double total = totalWeight;
+    while (a < centroidCount || b < count)
+    {
+        if (b == count || (a < centroidCount && centroids[a].mean <= incoming[b].mean))
+        {
+            sorted[n++] = centroids[a++];
+        }
+        else
+        {
+            total += incoming[b].weight;
+            sorted[n++] = incoming[b++];
+        }
+    }
+
+    centroidCount = 0;
+    Centroid current = sorted[0];
+    double weightSoFar = 0.0;
+    float kLimit = scaleK(0.0f) + 1.0f;
+
+    for (int i = 1; i < n; i++)
+    {
+        float q = (float)((weightSoFar + current.weight + sorted[i].weight) / total);
+        if (scaleK(q > 1.0f ? 1.0f : q) <= kLimit)
+        {
+            double w = current.weight + sorted[i].weight;
+            current.mean += (float)((sorted[i].mean - current.mean) * sorted[i].weight / w);
+            current.weight = w;
+        }
+        else
+        {
+            weightSoFar += current.weight;
+            centroids[centroidCount++] = current;
+            kLimit = scaleK((float)(weightSoFar / total)) + 1.0f;
+            current = sorted[i];
+        }
+    }
+    centroids[centroidCount++] = current;
+
+    totalWeight = total;
+}
+
+/*
+q = Quantile to estimate, 0.5 for the median, 0.9 for the 90th percentile
+
+Returns the estimated value, interpolated between centroid centres
+*/
+float QuantileSketch::quantile(float q) const
+{
+    if (centroidCount == 0)
+    {
+        return 0.0f;
+    }
+    if (q <= 0.0f)
+    {
+        return minValue;
+    }
+    if (q >= 1.0f)
+    {
+        return maxValue;
+    }
+
+    double target = q * totalWeight;
+    double before = 0.0;
+
+    for (int i = 0; i < centroidCount; i++)
+    {
+        double centre = before + centroids[i].weight / 2.0;
+        if (target < centre)
+        {
+            // Between the previous centre (or the minimum) and this one
+            float leftValue = i == 0 ? minValue : centroids[i - 1].mean;
+            double leftPos = i == 0 ? 0.0 : before - centroids[i - 1].weight / 2.0;
+            double span = centre - leftPos;
+            float t = span > 0.0 ? (float)((target - leftPos) / span) : 0.0f;
+            return leftValue + t * (centroids[i].mean - leftValue);
+        }
+        before += centroids[i].weight;
+    }
+
+    // Past the last centre, towards the maximum
+    int last = centroidCount - 1;
+    double leftPos = totalWeight - centroids[last].weight / 2.0;
+    double span = totalWeight - leftPos;
+    float t = span > 0.0 ? (float)((target - leftPos) / span) : 1.0f;
+    return centroids[last].mean + t * (maxValue - centroids[last].mean);
+}
+
+// Total weight of everything added or merged
+double QuantileSketch::count() const
+{
+    return totalWeight;
+}
+
+float QuantileSketch::min() const
+{
+    return minValue;
+}
+
+float QuantileSketch::max() const
+{
+    return maxValue;
+}
@@ -0,0 +1,44 @@
+#ifndef QUANTILE_H
+#define QUANTILE_H
+
+#define QUANTILE_MAX_CENTROIDS 64 // Centroids kept after compression
+
+/*
+Constant-memory streaming quantile estimate in the style of a merging
+t-digest. Values are summarised by weighted centroids that are kept small
+near the tails, so any quantile can be read at any time, and two sketches
+from concatenated sessions can be merged. Every insert is compressed
+straight away, so the queries never change the sketch.
+*/
+class QuantileSketch
+{
+public:
+    QuantileSketch();
+
+    void reset();
+    void add(float value, float weight = 1.0f);
+    void merge(const QuantileSketch &other);
+
+    float quantile(float q) const;
+    double count() const;
+    float min() const;
+    float max() const;
+
+private:
+    struct Centroid
+    {
+        float mean;
+        double weight; // Float weights stop counting at 2^24
+    };
+
+    void compress(const Centroid *incoming, int count);
+
+    Centroid centroids[QUANTILE_MAX_CENTROIDS];
+    int centroidCount;
+
+    double totalWeight;
+    float minValue;
+    float maxValue;
+};
+
+#endif /* QUANTILE_H */
@@ -0,0 +1,93 @@
+#ifndef SAMPLERING_H
+#define SAMPLERING_H
+
+/*
+Sliding window over the last length() samples of a stream. Every sample
+is stored twice, so window() is always one contiguous run, oldest sample
+first, that a transform or FIR can read without wrapping. push() also
+keeps the hop count between the windows a stage analyses, so the stages
+built on it only decide what to do with a window once it is due.
+*/
+template <typename T, int N>
+class SampleRing
+{
+    static_assert(N >= 1, "SampleRing must hold at least one sample");
+
+public:
+    /*
+    hop = Samples between due windows, see push()
+    length = Samples in the window, 1 to N, for stages sized at run time
+    */
+    SampleRing(int hop = 1, int length = N)
+        : span(length < 1 ? 1 : (length > N ? N : length)), hop(hop < 1 ? 1 : hop)
+    {
+        reset();
+    }
+
+    void reset()
+    {
+        for (int n = 0; n < 2 * N; n++)
+        {
+            samples[n] = T();
+        }
+        head = 0;
+        filled = 0;
+        sinceWindow = 0;
+    }
+
+    /*
+    sample = Newest sample of the stream
+
+    Returns true when a window is due: once when the ring first fills, then
+    after every hop samples
+    */
+    bool push(T sample)
+    {
+        samples[head] = samples[head + span] = sample;
+        head = (head + 1 == span) ? 0 : head + 1;
+
+        if (filled < span)
+        {
+            filled++;
+            if (filled < span)
+            {
+                return false;
+            }
+        }
+        else if (++sinceWindow < hop)
+        {
+            return false;
+        }
+
+        sinceWindow = 0;
+        return true;
+    }
+
+    // The last length() samples, oldest first, zeros until the ring has filled
+    const T *window() const
+    {
+        return &samples[head];
+    }
+
+    // True once length() samples have been pushed
+    bool full() const
+    {
+        return filled == span;
+    }
+
+    int length() const
+    {
+        return span;
+    }
+
+private:
+    int span;
+    int hop;
+
+    T samples[2 * N];
+    int head;
+    int filled;
+    int sinceWindow;
+};
+
+#endif /* SAMPLERING_H */
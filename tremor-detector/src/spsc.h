@@ -0,0 +1,139 @@
+#ifndef SPSC_H
+#define SPSC_H
+
+#include <atomic>
+#include <stdint.h>
+
+#define SPSC_CACHE_LINE 64 // Padding between the producer and consumer indices
+
+/*
+Wait-free single-producer single-consumer ring. One context, e.g. an
+interrupt, only ever calls the producer side and one thread only ever
+calls the consumer side; neither blocks nor disables interrupts.
+
+The indices run freely and are masked by the power-of-two capacity, so
+all Capacity slots are usable. Each side owns one index, published with
+release ordering and read by the other side with acquire ordering, so a
+slot's contents are visible before its index moves. Each side also
+caches the other's index and only reloads it when the ring looks full
+or empty, and the two sides sit on separate cache lines so they do not
+contend for one on a multi-core host.
+
+Producer: claim(), publish(), push()
+Consumer: pop(), pop(items, maxItems)
+*/
+template <typename T, int Capacity>
+class SpscRing
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "SpscRing capacity must be a power of two");
+
+public:
+    static constexpr int capacity = Capacity;
+
+    SpscRing() : head(0), cachedTail(0), tail(0), cachedHead(0)
+    {
+    }
+
+    /*
+    Returns the next free slot for the producer to fill in place, or
+    nullptr when the ring is full. The slot is not visible to the
+    consumer until publish().
+    */
+    T *claim()
+    {
+        uint32_t h = head.load(std::memory_order_relaxed);
+        if (h - cachedTail == (uint32_t)Capacity)
+        {
+            cachedTail = tail.load(std::memory_order_acquire);
+            if (h - cachedTail == (uint32_t)Capacity)
+            {
+                return nullptr;
+            }
+        }
+        return &items[h & MASK];
+    }
+
+    // Hands the slot returned by claim() to the consumer
+    void publish()
+    {
+        head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // Returns false, dropping item, when the ring is full
+    bool push(const T &item)
+    {
+        T *slot = claim();
+        if (slot == nullptr)
+        {
+            return false;
+        }
+        *slot = item;
+        publish();
+        return true;
+    }
+
+    // Returns false when the ring is empty
+    bool pop(T *item)
+    {
+        return pop(item, 1) == 1;
+    }
+
+    /*
+    items = Receives the oldest entries in order
+    maxItems = Room in items
+
+    Returns the number of entries moved out of the ring
+    */
+    int pop(T *items, int maxItems)
+    {
+        uint32_t t = tail.load(std::memory_order_relaxed);
+        if (cachedHead - t < (uint32_t)maxItems)
+        {
+            cachedHead = head.load(std::memory_order_acquire);
+        }
+
+        uint32_t available = cachedHead - t;
+        int count = available < (uint32_t)maxItems ? (int)available : maxItems;
+        for (int i = 0; i < count; i++)
+        {
+            items[i] = this->items[(t + i) & MASK];
+        }
+
+        tail.store(t + count, std::memory_order_release);
+        return count;
+    }
+
+    // Entries waiting, exact from either side, a lower bound from anywhere else
+    int size() const
+    {
+        uint32_t t = tail.load(std::memory_order_acquire);
+        uint32_t h = head.load(std::memory_order_acquire);
+        return (int)(h - t);
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+private:
+    static constexpr uint32_t MASK = Capacity - 1;
+
+    // Producer side
+    alignas(SPSC_CACHE_LINE) std::atomic<uint32_t> head;
+    uint32_t cachedTail;
+
+    // Consumer side
+    alignas(SPSC_CACHE_LINE) std::atomic<uint32_t> tail;
+    uint32_t cachedHead;
+
+    alignas(SPSC_CACHE_LINE) T items[Capacity];
+};
+
+template <typename T, int Capacity>
+constexpr int SpscRing<T, Capacity>::capacity;
+
+template <typename T, int Capacity>
+constexpr uint32_t SpscRing<T, Capacity>::MASK;
+
+#endif /* SPSC_H */
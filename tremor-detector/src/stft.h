@@ -0,0 +1,222 @@
+#ifndef STFT_H
+#define STFT_H
+
+#include <math.h>
+
+#include "fft.h"
+#include "samplering.h"
+
+/*
+Zero-copy view of the stored spectrogram. The frames are split in two
+contiguous runs because the store is circular: first holds the oldest
+firstFrames frames, second the newer secondFrames frames. Every frame is
+bins floats, lowest frequency first.
+*/
+struct SpectrogramView
+{
+    const float *first;
+    int firstFrames;
+    const float *second;
+    int secondFrames;
+    int bins;
+};
+
+/*
+N = FFT length of a frame
+sampleRate = Sampling rate of the incoming signal
+minFreq = Lowest frequency of the band
+maxFreq = Highest frequency of the band
+
+Returns the number of bins a Spectrogram keeps for the band, usable as
+its Bins parameter
+*/
+constexpr int spectrogramBins(int N, float sampleRate, float minFreq, float maxFreq)
+{
+    int first = (int)(minFreq * N / sampleRate);
+    int last = (int)(maxFreq * N / sampleRate);
+    if (last < maxFreq * N / sampleRate)
+    {
+        last++;
+    }
+    if (first < 0)
+    {
+        first = 0;
+    }
+    if (last > N / 2)
+    {
+        last = N / 2;
+    }
+    return last >= first ? last - first + 1 : 0;
+}
+
+/*
+Short-time Fourier transform that keeps the band-limited power of the
+last Frames frames in a fixed circular store. A frame is produced every
+hop samples from the last N samples, so history is never recomputed.
+The store holds Bins columns per frame, which only needs to cover the
+band, see spectrogramBins().
+*/
+template <int N, int Frames, int Bins>
+class Spectrogram
+{
+    static_assert(Bins >= 1 && Bins <= N / 2 + 1, "Spectrogram band must be 1 to N / 2 + 1 bins wide");
+
+public:
+    /*
+    hop = Number of samples between frames
+    sampleRate = Sampling rate of the incoming signal
+    minFreq = Lowest frequency kept in each frame
+    maxFreq = Highest frequency kept in each frame, lowered when the band
+              is wider than Bins
+    window = Window applied to every frame
+    */
+    Spectrogram(int hop, float sampleRate, float minFreq, float maxFreq, WindowType window = WINDOW_HANN)
+        : window(window), ring(hop)
+    {
+        minBin = (int)floor(minFreq * N / sampleRate);
+        int maxBin = (int)ceil(maxFreq * N / sampleRate);
+        if (minBin < 0)
+        {
+            minBin = 0;
+        }
+        if (maxBin > N / 2)
+        {
+            maxBin = N / 2;
+        }
+        bins = maxBin >= minBin ? maxBin - minBin + 1 : 0;
+        if (bins > Bins)
+        {
+            bins = Bins;
+        }
+
+        for (int i = 0; i < bins; i++)
+        {
+            columnFreq[i] = (minBin + i) * sampleRate / N;
+        }
+
+        reset();
+    }
+
+    void reset()
+    {
+        ring.reset();
+        newest = -1;
+        frames = 0;
+    }
+
+    /*
+    sample = Newest sample of the signal
+
+    Returns true when the sample completed a new frame
+    */
+    bool push(float sample)
+    {
+        if (!ring.push(sample))
+        {
+            return false;
+        }
+
+        addFrame();
+        return true;
+    }
+
+    // Number of frames currently stored
+    int frameCount() const
+    {
+        return frames;
+    }
+
+    int binCount() const
+    {
+        return bins;
+    }
+
+    float binFrequency(int bin) const
+    {
+        return columnFreq[bin];
+    }
+
+    /*
+    age = 0 for the newest frame, up to frameCount() - 1 for the oldest
+    bin = Column within the band
+    */
+    float power(int age, int bin) const
+    {
+        return store[slot(age) * bins + bin];
+    }
+
+    // Total band power of a frame
+    float bandPower(int age) const
+    {
+        return totals[slot(age)];
+    }
+
+    const float *frame(int age) const
+    {
+        return &store[slot(age) * bins];
+    }
+
+    // The whole stored history, oldest frame first, without copying
+    SpectrogramView view() const
+    {
+        SpectrogramView v;
+        int oldest = slot(frames - 1);
+        v.bins = bins;
+        v.first = &store[oldest * bins];
+        if (oldest + frames <= Frames)
+        {
+            v.firstFrames = frames;
+            v.second = 0;
+            v.secondFrames = 0;
+        }
+        else
+        {
+            v.firstFrames = Frames - oldest;
+            v.second = store;
+            v.secondFrames = frames - v.firstFrames;
+        }
+        return v;
+    }
+
+private:
+    int slot(int age) const
+    {
+        int s = newest - age;
+        return s < 0 ? s + Frames : s;
+    }
+
+    void addFrame()
+    {
+        Fft<N>::powerSpectrum(ring.window(), spectrum, window);
+
+        newest = (newest + 1 == Frames) ? 0 : newest + 1;
+        if (frames < Frames)
+        {
+            frames++;
+        }
+
+        float *row = &store[newest * bins];
+        float total = 0.0f;
+        for (int i = 0; i < bins; i++)
+        {
+            row[i] = spectrum[minBin + i];
+            total += row[i];
+        }
+        totals[newest] = total;
+    }
+
+    WindowType window;
+    int minBin;
+    int bins;
+    float columnFreq[Bins];
+
+    SampleRing<float, N> ring; // Hops by the frame spacing
+
+    float spectrum[N / 2 + 1];
+    float store[Frames * Bins];
+    float totals[Frames];
+    int newest;
+    int frames;
+};
+
+#endif /* STFT_H */
@@ -0,0 +1,146 @@
+#ifndef SUMMARY_H
+#define SUMMARY_H
+
+#include <math.h>
+#include <stdint.h>
+
+// Range of bins covering a frequency band, resolved once per summary
+struct BandBins
+{
+    int first;
+    int last;
+};
+
+/*
+Per-frame summary of an N point power spectrum. update() builds a
+cumulative power array and a sparse table of maxima once per frame, after
+which the total, mean and maximum of any band are constant-time lookups.
+*/
+template <int N>
+class SpectrumSummary
+{
+public:
+    static constexpr int bins = N / 2 + 1;
+
+    /*
+    sampleRate = Sampling rate of the signal the spectra are computed from
+    */
+    SpectrumSummary(float sampleRate)
+        : binsPerHz(N / sampleRate), spectrum(0)
+    {
+        cumulative[0] = 0.0;
+    }
+
+    /*
+    minFreq = Lowest frequency of the band
+    maxFreq = Highest frequency of the band
+
+    Returns the bins covering the band, to be kept by the caller across frames
+    */
+    BandBins band(float minFreq, float maxFreq) const
+    {
+        BandBins b;
+        b.first = (int)floor(minFreq * binsPerHz);
+        b.last = (int)ceil(maxFreq * binsPerHz);
+        if (b.first < 0)
+        {
+            b.first = 0;
+        }
+        if (b.last > bins - 1)
+        {
+            b.last = bins - 1;
+        }
+        return b;
+    }
+
+    /*
+    power = Power spectrum of the frame, the N / 2 + 1 bins written by rdft().
+            It is referenced, not copied, and must stay valid until the next update.
+    */
+    void update(const float *power)
+    {
+        spectrum = power;
+
+        // Kept in double, a float running sum carries the DC and low-bin power
+        // into every later entry and band differences lose their precision
+        for (int k = 0; k < bins; k++)
+        {
+            cumulative[k + 1] = cumulative[k] + power[k];
+            peak[0][k] = (uint16_t)k;
+        }
+
+        // peak[l][k] is the strongest bin of the 2^l bins starting at k
+        for (int l = 1; l < LEVELS; l++)
+        {
+            int span = 1 << (l - 1);
+            for (int k = 0; k + 2 * span <= bins; k++)
+            {
+                int a = peak[l - 1][k], b = peak[l - 1][k + span];
+                peak[l][k] = power[b] > power[a] ? (uint16_t)b : (uint16_t)a;
+            }
+        }
+    }
+
+    float total(BandBins b) const
+    {
+        if (b.last < b.first)
+        {
+            return 0.0f;
+        }
+        return (float)(cumulative[b.last + 1] - cumulative[b.first]);
+    }
+
+    float mean(BandBins b) const
+    {
+        if (b.last < b.first)
+        {
+            return 0.0f;
+        }
+        return total(b) / (b.last - b.first + 1);
+    }
+
+    // Strongest bin of the band, -1 for an empty band
+    int peakBin(BandBins b) const
+    {
+        if (b.last < b.first)
+        {
+            return -1;
+        }
+
+        // Two overlapping power-of-two runs cover the band
+        int length = b.last - b.first + 1;
+        int l = 0;
+        while ((2 << l) <= length)
+        {
+            l++;
+        }
+        int i = peak[l][b.first], j = peak[l][b.last - (1 << l) + 1];
+        return spectrum[j] > spectrum[i] ? j : i;
+    }
+
+    float max(BandBins b) const
+    {
+        int k = peakBin(b);
+        return k < 0 ? 0.0f : spectrum[k];
+    }
+
+    float binFrequency(int bin) const
+    {
+        return bin / binsPerHz;
+    }
+
+private:
+    static constexpr int levelsFor(int n)
+    {
+        return n <= 1 ? 1 : 1 + levelsFor(n / 2);
+    }
+
+    static constexpr int LEVELS = levelsFor(bins);
+
+    float binsPerHz;
+    const float *spectrum;
+    double cumulative[bins + 1];
+    uint16_t peak[LEVELS][bins];
+};
+
+#endif /* SUMMARY_H */
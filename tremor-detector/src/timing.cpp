@@ -0,0 +1,85 @@
+#include <math.h>
+
+#include "timing.h"
+
+SampleClock::SampleClock()
+{
+    reset();
+}
+
+void SampleClock::reset()
+{
+    lastTimestamp = 0;
+    ticks = 0;
+    mean = 0.0;
+    m2 = 0.0;
+    shortest = 0;
+    longest = 0;
+}
+
+/*
+timestampUs = Free-running microsecond count at the sample instant. The
+              interval is taken modulo 2^32 so the counter may wrap.
+*/
+void SampleClock::tick(uint32_t timestampUs)
+{
+    if (ticks > 0)
+    {
+        uint32_t interval = timestampUs - lastTimestamp;
+        uint32_t n = ticks; // Intervals seen including this one
+
+        double delta = (double)interval - mean;
+        mean += delta / n;
+        m2 += delta * ((double)interval - mean);
+
+        if (n == 1 || interval < shortest)
+        {
+            shortest = interval;
+        }
+        if (n == 1 || interval > longest)
+        {
+            longest = interval;
+        }
+    }
+
+    lastTimestamp = timestampUs;
+    ticks++;
+}
+
+// Timestamps seen since the last reset
+uint32_t SampleClock::count() const
+{
+    return ticks;
+}
+
+// Mean sample interval in microseconds
+float SampleClock::meanInterval() const
+{
+    return (float)mean;
+}
+
+// Standard deviation of the sample interval in microseconds
+float SampleClock::jitter() const
+{
+    if (ticks < 3)
+    {
+        return 0.0f;
+    }
+    return (float)sqrt(m2 / (ticks - 2));
+}
+
+float SampleClock::minInterval() const
+{
+    return (float)shortest;
+}
+
+float SampleClock::maxInterval() const
+{
+    return (float)longest;
+}
+
+// Measured sample rate in Hz, 0 until two timestamps have been seen
+float SampleClock::rate() const
+{
+    return mean > 0.0 ? (float)(1.0e6 / mean) : 0.0f;
+}
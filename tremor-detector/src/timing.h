@@ -0,0 +1,39 @@
+#ifndef TIMING_H
+#define TIMING_H
+
+#include <stdint.h>
+
+/*
+Running statistics of the interval between sample timestamps. tick() is
+constant time and allocation free, so it can be fed from the interrupt
+that captures each timestamp. Jitter is the standard deviation of the
+intervals, the figure that smears a spectral estimate.
+*/
+class SampleClock
+{
+public:
+    SampleClock();
+
+    void reset();
+    void tick(uint32_t timestampUs);
+
+    uint32_t count() const;
+    float meanInterval() const;
+    float jitter() const;
+    float minInterval() const;
+    float maxInterval() const;
+    float rate() const;
+
+private:
+    uint32_t lastTimestamp;
+    uint32_t ticks;
+
+    // Welford's running mean and sum of squared deviations, in double as
+    // float stops resolving a 10 ms interval's updates within hours
+    double mean;
+    double m2;
+    uint32_t shortest;
+    uint32_t longest;
+};
+
+#endif /* TIMING_H */
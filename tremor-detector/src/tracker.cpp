@@ -0,0 +1,171 @@
+#include <math.h>
+
+#include "tracker.h"
+
+#define AMPLITUDE_NOISE 0.3f // Relative measurement noise of the peak power
+#define AMPLITUDE_DRIFT 0.2f // Relative change of the peak power per second
+
+static void cvInit(KalmanCv *k, float value, float variance)
+{
+    k->value = value;
+    k->rate = 0.0f;
+    k->p00 = variance;
+    k->p01 = 0.0f;
+    k->p11 = variance;
+}
+
+/*
+k = Filter to advance
+dt = Time step in seconds
+q = Spectral density of the white acceleration driving the rate
+*/
+static void cvPredict(KalmanCv *k, float dt, float q)
+{
+    k->value += k->rate * dt;
+
+    // P = F P F' + Q for F = [1 dt; 0 1]
+    float p00 = k->p00 + dt * (2.0f * k->p01 + dt * k->p11);
+    float p01 = k->p01 + dt * k->p11;
+    float p11 = k->p11;
+
+    k->p00 = p00 + q * dt * dt * dt / 3.0f;
+    k->p01 = p01 + q * dt * dt / 2.0f;
+    k->p11 = p11 + q * dt;
+}
+
+static void cvCorrect(KalmanCv *k, float measurement, float r)
+{
+    float s = k->p00 + r;
+    float g0 = k->p00 / s;
+    float g1 = k->p01 / s;
+    float innovation = measurement - k->value;
+
+    k->value += g0 * innovation;
+    k->rate += g1 * innovation;
+
+    float p00 = (1.0f - g0) * k->p00;
+    float p01 = (1.0f - g0) * k->p01;
+    float p11 = k->p11 - g1 * k->p01;
+    k->p00 = p00;
+    k->p01 = p01;
+    k->p11 = p11;
+}
+
+/*
+frequencyNoise = Standard deviation of a peak frequency measurement in Hz
+frequencyDrift = How fast the tremor frequency may wander, in Hz per second
+gateSigmas = Innovations beyond this many standard deviations are rejected
+maxMisses = Consecutive rejected frames before the track is dropped
+minSnr = Peak SNR a measurement needs to start or extend the track. The
+         default sits near the 99th percentile of a noise-only band.
+*/
+PeakTracker::PeakTracker(float frequencyNoise, float frequencyDrift, float gateSigmas, int maxMisses, float minSnr)
+    : frequencyNoise(frequencyNoise), frequencyDrift(frequencyDrift),
+      gateSigmas(gateSigmas), maxMisses(maxMisses), minSnr(minSnr)
+{
+    reset();
+}
+
+void PeakTracker::reset()
+{
+    locked = false;
+    misses = 0;
+    cvInit(&freq, 0.0f, 0.0f);
+    cvInit(&amp, 0.0f, 0.0f);
+}
+
+/*
+peak = Peak measured in the current frame, from detectPeak() or detectPeakNear()
+dt = Time since the previous frame in seconds
+
+Returns true when the measurement was accepted into the track
+*/
+bool PeakTracker::update(const TremorPeak &peak, float dt)
+{
+    float r = frequencyNoise * frequencyNoise;
+
+    // The detectors always return their strongest bin, even from pure noise
+    bool present = peak.bin != -1 && peak.snr >= minSnr;
+
+    if (!locked)
+    {
+        if (!present)
+        {
+            return false;
+        }
+        cvInit(&freq, peak.frequency, r);
+        cvInit(&amp, peak.power, peak.power * peak.power * AMPLITUDE_NOISE * AMPLITUDE_NOISE);
+        locked = true;
+        misses = 0;
+        return true;
+    }
+
+    float q = frequencyDrift * frequencyDrift;
+    cvPredict(&freq, dt, q);
+    float ampDrift = AMPLITUDE_DRIFT * amp.value;
+    cvPredict(&amp, dt, ampDrift * ampDrift);
+
+    // Gate on the frequency innovation
+    float innovation = peak.frequency - freq.value;
+    float limit = gateSigmas * sqrtf(freq.p00 + r);
+    if (!present || fabsf(innovation) > limit)
+    {
+        if (++misses > maxMisses)
+        {
+            reset();
+        }
+        return false;
+    }
+
+    misses = 0;
+    cvCorrect(&freq, peak.frequency, r);
+    float ampNoise = AMPLITUDE_NOISE * (amp.value > peak.power ? amp.value : peak.power);
+    cvCorrect(&amp, peak.power, ampNoise * ampNoise);
+    return true;
+}
+
+bool PeakTracker::tracking() const
+{
+    return locked;
+}
+
+// Filtered peak frequency in Hz
+float PeakTracker::frequency() const
+{
+    return freq.value;
+}
+
+// Filtered peak power
+float PeakTracker::amplitude() const
+{
+    return amp.value;
+}
+
+float PeakTracker::predictedFrequency(float dt) const
+{
+    return freq.value + freq.rate * dt;
+}
+
+/*
+dt = Time until the next frame in seconds
+sigmas = Width of the window in standard deviations of the prediction
+minFreq, maxFreq = Receive the window to pass to detectPeakNear()
+
+Leaves the window untouched while no track is held, so callers can
+preset it to the full tremor band
+*/
+void PeakTracker::searchWindow(float dt, float sigmas, float *minFreq, float *maxFreq) const
+{
+    if (!locked)
+    {
+        return;
+    }
+
+    float p00 = freq.p00 + dt * (2.0f * freq.p01 + dt * freq.p11) +
+                frequencyDrift * frequencyDrift * dt * dt * dt / 3.0f;
+    float halfWidth = sigmas * sqrtf(p00 + frequencyNoise * frequencyNoise);
+    float centre = predictedFrequency(dt);
+
+    *minFreq = centre - halfWidth;
+    *maxFreq = centre + halfWidth;
+}
@@ -0,0 +1,53 @@
+#ifndef TRACKER_H
+#define TRACKER_H
+
+#include "detection.h"
+
+/*
+Constant-velocity Kalman filter over one scalar, holding the value, its
+rate of change and their 2x2 covariance.
+*/
+struct KalmanCv
+{
+    float value;
+    float rate;
+    float p00, p01, p11;
+};
+
+/*
+Carries the tremor peak across frames. Frequency and amplitude are each
+tracked by a constant-velocity Kalman filter. Measurements that do not
+stand out of the background, or whose frequency falls outside the gate
+around the prediction, are rejected as voluntary movement or noise. The
+prediction also gives the spectral stage a narrow window to search in the
+next frame.
+*/
+class PeakTracker
+{
+public:
+    PeakTracker(float frequencyNoise = 0.2f, float frequencyDrift = 0.05f,
+                float gateSigmas = 3.0f, int maxMisses = 5, float minSnr = 10.0f);
+
+    void reset();
+    bool update(const TremorPeak &peak, float dt);
+
+    bool tracking() const;
+    float frequency() const;
+    float amplitude() const;
+    float predictedFrequency(float dt) const;
+    void searchWindow(float dt, float sigmas, float *minFreq, float *maxFreq) const;
+
+private:
+    float frequencyNoise;
+    float frequencyDrift;
+    float gateSigmas;
+    int maxMisses;
+    float minSnr;
+
+    KalmanCv freq;
+    KalmanCv amp;
+    bool locked;
+    int misses;
+};
+
+#endif /* TRACKER_H */
@@ -0,0 +1,69 @@
+#include "tremor.h"
+
+// Band-pass coefficients for 19 Hz, gain 0.8 at 3 Hz, 1.0 at 4 to 5 Hz and 0.55 at 6 Hz
+static const float feedback[5] = {1.0, -0.482, 0.810, -0.227, 0.272};
+static const float forward[5] = {0.131, 0.0, -0.262, 0.0, 0.131};
+
+/*
+envelopeTaps = Length of the Hilbert transformer, see HilbertEnvelope
+*/
+TremorFilter::TremorFilter(int envelopeTaps) : envelope(envelopeTaps)
+{
+    reset();
+}
+
+void TremorFilter::reset()
+{
+    for (int i = 0; i < 5; i++)
+    {
+        input[i] = 0.0f;
+        filtered[i] = 0;
+    }
+    envelope.reset();
+    level = 0.0f;
+}
+
+/*
+velocity = Newest angular velocity sample at the decimated rate
+steady = False while the other axes move, the amplitude then reads zero
+
+Returns the tremor amplitude, see amplitude()
+*/
+float TremorFilter::push(int16_t velocity, bool steady)
+{
+    for (int i = 4; i > 0; --i)
+    {
+        input[i] = input[i - 1];
+        filtered[i] = filtered[i - 1];
+    }
+    input[0] = velocity;
+
+    // Each term is truncated to the 16 bit output, as the filter was designed
+    filtered[0] = forward[0] * input[0];
+    for (int i = 1; i < 5; ++i)
+    {
+        filtered[0] += int16_t(forward[i] * input[i] - feedback[i] * filtered[i]);
+    }
+
+    envelope.push(filtered[0]);
+    level = steady ? envelope.amplitude() : 0.0f;
+    return level;
+}
+
+// Band-pass filtered velocity of the last sample
+int16_t TremorFilter::output() const
+{
+    return filtered[0];
+}
+
+// Tremor amplitude of the sample latency() samples ago, zero while not steady
+float TremorFilter::amplitude() const
+{
+    return level;
+}
+
+// Delay in samples of the amplitude behind the band-pass output
+int TremorFilter::latency() const
+{
+    return envelope.latency();
+}
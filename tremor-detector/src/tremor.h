@@ -0,0 +1,37 @@
+#ifndef TREMOR_H
+#define TREMOR_H
+
+#include <stdint.h>
+
+#include "hilbert.h"
+
+#define TREMOR_ENVELOPE_TAPS 7 // Hilbert transformer length, within 6% from 3 to 6 Hz at 19 Hz
+
+/*
+Tremor band filter and amplitude at the decimated rate. A fourth-order IIR
+band-pass keeps the 3 to 6 Hz band of the angular velocity and a short
+Hilbert transformer turns it into an instantaneous amplitude, in the same
+units as the velocity. Nothing is averaged after the envelope, so an onset
+shows up as soon as the band-pass and latency() samples have passed it.
+*/
+class TremorFilter
+{
+public:
+    TremorFilter(int envelopeTaps = TREMOR_ENVELOPE_TAPS);
+
+    void reset();
+    float push(int16_t velocity, bool steady);
+
+    int16_t output() const;
+    float amplitude() const;
+    int latency() const;
+
+private:
+    float input[5];
+    int16_t filtered[5];
+
+    HilbertEnvelope envelope;
+    float level;
+};
+
+#endif /* TREMOR_H */
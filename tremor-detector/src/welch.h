@@ -0,0 +1,111 @@
+#ifndef WELCH_H
+#define WELCH_H
+
+#include "fft.h"
+#include "samplering.h"
+
+/*
+Streaming Welch power spectral density estimate. Samples are pushed one at
+a time into a ring of the last N points; every hop a windowed segment is
+transformed and folded into a running average, so spectrum() is always
+current without revisiting old segments.
+*/
+template <int N>
+class WelchPsd
+{
+public:
+    /*
+    overlapPercent = Overlap between consecutive segments, 0, 50 or 75
+    maxSegments = Segments in the average before it turns into a moving
+                  exponential average of the same length, at least 1
+    window = Window applied to every segment
+    */
+    WelchPsd(int overlapPercent = 50, int maxSegments = 8, WindowType window = WINDOW_HANN)
+        : maxSegments(maxSegments), window(window), ring(N * (100 - overlapPercent) / 100)
+    {
+        if (this->maxSegments < 1)
+        {
+            this->maxSegments = 1;
+        }
+
+        // Undo the noise power lost to the window so levels match an unwindowed rdft()
+        float gain = Fft<N>::coherentGain(window);
+        windowScale = 1.0f / (gain * gain * Fft<N>::enbw(window));
+
+        reset();
+    }
+
+    void reset()
+    {
+        ring.reset();
+        for (int k = 0; k < Fft<N>::bins; k++)
+        {
+            average[k] = 0.0f;
+        }
+        count = 0;
+    }
+
+    /*
+    sample = Newest sample of the signal
+
+    Returns true when the sample completed a segment and the average changed
+    */
+    bool push(float sample)
+    {
+        if (!ring.push(sample))
+        {
+            return false;
+        }
+
+        addSegment(ring.window());
+        return true;
+    }
+
+    void push(const float *samples, int size)
+    {
+        for (int n = 0; n < size; n++)
+        {
+            push(samples[n]);
+        }
+    }
+
+    // Averaged power spectrum, N / 2 + 1 bins normalised like rdft()
+    const float *spectrum() const
+    {
+        return average;
+    }
+
+    int segments() const
+    {
+        return count;
+    }
+
+private:
+    void addSegment(const float *segment)
+    {
+        Fft<N>::powerSpectrum(segment, segmentPower, window);
+
+        if (count < maxSegments)
+        {
+            count++;
+        }
+        float weight = 1.0f / count;
+
+        for (int k = 0; k < Fft<N>::bins; k++)
+        {
+            average[k] += (segmentPower[k] * windowScale - average[k]) * weight;
+        }
+    }
+
+    int maxSegments;
+    WindowType window;
+    float windowScale;
+
+    SampleRing<float, N> ring; // Hops by the segment overlap
+    int count;
+
+    float segmentPower[Fft<N>::bins];
+    float average[Fft<N>::bins];
+};
+
+#endif /* WELCH_H */
@@ -0,0 +1,168 @@
+#ifndef ZOOM_H
+#define ZOOM_H
+
+#include <math.h>
+
+#include "decimator.h"
+#include "fft.h"
+#include "samplering.h"
+
+/*
+sampleRate = Sampling rate of the incoming signal
+minFreq = Lowest frequency of the band
+maxFreq = Highest frequency of the band
+
+Returns the largest decimation that keeps the band within the flat middle
+half of the decimated span, usable as the Decimation parameter of ZoomFft
+*/
+constexpr int zoomDecimation(float sampleRate, float minFreq, float maxFreq)
+{
+    int factor = (int)(sampleRate / (2.0f * (maxFreq - minFreq)));
+    return factor < 1 ? 1 : factor;
+}
+
+/*
+Zoom FFT over one frequency band. Incoming samples are mixed down so the
+band centre sits at 0 Hz, low-pass filtered and decimated by a Decimator
+on each of the I and Q channels, and the decimated complex stream is
+analysed with an N point FFT. The N bins then span only the band of interest,
+giving a resolution of sampleRate / (Decimation * N).
+*/
+template <int N, int Decimation>
+class ZoomFft
+{
+public:
+    /*
+    sampleRate = Sampling rate of the incoming signal
+    minFreq = Lowest frequency of the band
+    maxFreq = Highest frequency of the band, at most sampleRate / (2 * Decimation)
+              above minFreq, see zoomDecimation()
+    window = Window applied to each block of decimated samples
+    */
+    ZoomFft(float sampleRate, float minFreq, float maxFreq, WindowType window = WINDOW_HANN)
+        : window(window), ringReal(N / 2), ringImag(N / 2)
+    {
+        centre = 0.5f * (minFreq + maxFreq);
+        span = sampleRate / Decimation;
+
+        double step = -2 * FFT_PI * centre / sampleRate;
+        stepReal = (float)cos(step);
+        stepImag = (float)sin(step);
+
+        reset();
+    }
+
+    void reset()
+    {
+        phaseReal = 1.0f;
+        phaseImag = 0.0f;
+        mixReal.reset();
+        mixImag.reset();
+        ringReal.reset();
+        ringImag.reset();
+
+        for (int i = 0; i < N; i++)
+        {
+            power[i] = 0.0f;
+        }
+    }
+
+    /*
+    sample = Newest sample of the signal
+
+    Returns true when the sample completed a new zoomed spectrum
+    */
+    bool push(float sample)
+    {
+        // Mix down by the band centre
+        float inReal = sample * phaseReal;
+        float inImag = sample * phaseImag;
+
+        float t = phaseReal;
+        phaseReal = t * stepReal - phaseImag * stepImag;
+        phaseImag = t * stepImag + phaseImag * stepReal;
+
+        // Pull the oscillator back onto the unit circle
+        float g = 1.5f - 0.5f * (phaseReal * phaseReal + phaseImag * phaseImag);
+        phaseReal *= g;
+        phaseImag *= g;
+
+        // Both channels decimate in step, so one result says whether a sample is out
+        float outReal, outImag;
+        mixImag.push(inImag, &outImag);
+        if (!mixReal.push(inReal, &outReal))
+        {
+            return false;
+        }
+
+        // Both rings hop in step, blocks overlap by half
+        ringImag.push(outImag);
+        if (!ringReal.push(outReal))
+        {
+            return false;
+        }
+
+        analyse(ringReal.window(), ringImag.window());
+        return true;
+    }
+
+    // Power of each zoomed bin, ordered from the lowest to the highest frequency
+    const float *spectrum() const
+    {
+        return power;
+    }
+
+    float binFrequency(int i) const
+    {
+        return centre + (i - N / 2) * resolution();
+    }
+
+    float resolution() const
+    {
+        return span / N;
+    }
+
+    int decimationFactor() const
+    {
+        return Decimation;
+    }
+
+private:
+    void analyse(const float *re, const float *im)
+    {
+        const float *w = Fft<N>::window(window);
+        for (int n = 0; n < N; n++)
+        {
+            int j = Fft<N>::tables.bitrev[n];
+            workReal[j] = re[n] * w[n];
+            workImag[j] = im[n] * w[n];
+        }
+
+        Fft<N>::transformBitReversed(workReal, workImag);
+
+        // Negative frequencies sit in the upper half of the FFT output
+        for (int i = 0; i < N; i++)
+        {
+            int k = (i + N / 2) & (N - 1);
+            power[i] = ((workReal[k] * workReal[k]) + (workImag[k] * workImag[k])) / N;
+        }
+    }
+
+    WindowType window;
+    float centre;
+    float span;
+
+    float stepReal, stepImag;
+    float phaseReal, phaseImag;
+    Decimator<Decimation> mixReal;
+    Decimator<Decimation> mixImag;
+
+    SampleRing<float, N> ringReal;
+    SampleRing<float, N> ringImag;
+
+    float workReal[N];
+    float workImag[N];
+    float power[N];
+};
+
+#endif /* ZOOM_H */
@@ -0,0 +1,131 @@
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <unity.h>
+
+#include "dft.h"
+
+#define PI 3.1415926535897932385
+
+static float signal[FFT_MAX_POINTS];
+static float expected[FFT_MAX_POINTS];
+static float actual[FFT_MAX_POINTS];
+
+// The direct O(N^2) dft() the FFT replaced, kept as the reference
+static void referenceDft(float *x, int size, int N, float *power)
+{
+    float Xreal, Ximag;
+    for (int k = 0; k < N; k++)
+    {
+        Xreal = 0.0;
+        Ximag = 0.0;
+
+        for (int n = 0; n < size; n++)
+        {
+            Xreal += x[n] * cos(2 * PI * k * n / N);
+            Ximag -= x[n] * sin(2 * PI * k * n / N);
+        }
+
+        power[k] = ((Xreal * Xreal) + (Ximag * Ximag)) / size;
+    }
+}
+
+// Gyro-like test signal: offset, a 5 Hz tremor, a slower sway and a little noise
+static void makeSignal(int size, float sampleRate)
+{
+    unsigned int seed = 12345;
+    for (int n = 0; n < size; n++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        float noise = ((seed >> 16) & 0x7FFF) / 32768.0f - 0.5f;
+        float t = n / sampleRate;
+        signal[n] = 0.3f + 2.0f * sinf(2 * PI * 5.0f * t) + 0.7f * sinf(2 * PI * 1.3f * t) + 0.1f * noise;
+    }
+}
+
+// Microseconds per call of transform, averaged over enough calls to be measurable
+template <typename Transform>
+static double timeTransform(Transform transform, int N)
+{
+    int repeats = 1;
+    for (;;)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < repeats; r++)
+        {
+            transform(signal, N, N, actual);
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        double us = std::chrono::duration<double, std::micro>(elapsed).count();
+        if (us > 20000.0 || repeats >= (1 << 20))
+        {
+            return us / repeats;
+        }
+        repeats *= 2;
+    }
+}
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+void test_fft_matches_reference()
+{
+    for (int N = 8; N <= FFT_MAX_POINTS; N *= 2)
+    {
+        makeSignal(N, 95.0f);
+        referenceDft(signal, N, N, expected);
+        dft(signal, N, N, actual);
+
+        float peak = 0.0f;
+        for (int k = 0; k < N; k++)
+        {
+            peak = expected[k] > peak ? expected[k] : peak;
+        }
+        for (int k = 0; k < N; k++)
+        {
+            TEST_ASSERT_FLOAT_WITHIN(1e-4f * peak, expected[k], actual[k]);
+        }
+    }
+}
+
+void test_non_power_of_two_matches_reference()
+{
+    makeSignal(100, 95.0f);
+    referenceDft(signal, 100, 100, expected);
+    dft(signal, 100, 100, actual);
+
+    for (int k = 0; k < 100; k++)
+    {
+        TEST_ASSERT_FLOAT_WITHIN(1e-3f * (expected[k] + 1.0f), expected[k], actual[k]);
+    }
+}
+
+void test_fft_benchmark()
+{
+    char line[96];
+    for (int N = 64; N <= FFT_MAX_POINTS; N *= 2)
+    {
+        makeSignal(N, 95.0f);
+        double direct = timeTransform(referenceDft, N);
+        double fast = timeTransform(dft, N);
+
+        snprintf(line, sizeof(line), "N=%4d  direct %10.1f us  fft %8.2f us  speedup %6.1fx",
+                 N, direct, fast, direct / fast);
+        TEST_MESSAGE(line);
+        TEST_ASSERT_TRUE(fast < direct);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_fft_matches_reference);
+    RUN_TEST(test_non_power_of_two_matches_reference);
+    RUN_TEST(test_fft_benchmark);
+    return UNITY_END();
+}
@@ -0,0 +1,106 @@
+#include <math.h>
+#include <unity.h>
+
+#include "dft.h"
+#include "fixed_fft.h"
+#include "vectors.h"
+
+static int32_t power[FIXED_FFT_MAX_POINTS / 2 + 1];
+static int32_t widePower[FIXED_FFT_MAX_POINTS + 1];
+static float floatInput[FIXED_FFT_MAX_POINTS];
+static float floatPower[FIXED_FFT_MAX_POINTS / 2 + 1];
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+void test_rdft_fixed_gyro_vector()
+{
+    int exponent = rdftFixed(gyroInput, 64, power);
+
+    TEST_ASSERT_EQUAL_INT(GYRO_EXPONENT, exponent);
+    TEST_ASSERT_EQUAL_INT32_ARRAY(gyroPower, power, 33);
+}
+
+void test_rdft_fixed_full_scale_vector()
+{
+    int exponent = rdftFixed(fullScaleInput, 256, power);
+
+    TEST_ASSERT_EQUAL_INT(FULL_SCALE_EXPONENT, exponent);
+    TEST_ASSERT_EQUAL_INT32_ARRAY(fullScalePower, power, 129);
+}
+
+void test_fixed_fft_complex_vector()
+{
+    int16_t re[32], im[32];
+    for (int n = 0; n < 32; n++)
+    {
+        re[n] = complexInputReal[n];
+        im[n] = complexInputImag[n];
+    }
+
+    int exponent = fixedFft(re, im, 32);
+
+    TEST_ASSERT_EQUAL_INT(COMPLEX_EXPONENT, exponent);
+    TEST_ASSERT_EQUAL_INT16_ARRAY(complexOutputReal, re, 32);
+    TEST_ASSERT_EQUAL_INT16_ARRAY(complexOutputImag, im, 32);
+}
+
+// Lengths the twiddle table cannot serve must not index past it
+void test_rdft_fixed_rejects_bad_lengths()
+{
+    const int lengths[] = {48, 2 * FIXED_FFT_MAX_POINTS};
+    for (int l = 0; l < 2; l++)
+    {
+        int N = lengths[l];
+        for (int k = 0; k <= FIXED_FFT_MAX_POINTS; k++)
+        {
+            widePower[k] = -1;
+        }
+
+        int exponent = rdftFixed(fullScaleInput, N, widePower);
+
+        TEST_ASSERT_EQUAL_INT(0, exponent);
+        for (int k = 0; k <= N / 2; k++)
+        {
+            TEST_ASSERT_EQUAL_INT32(0, widePower[k]);
+        }
+    }
+}
+
+// The vectors themselves must stay close to the float path they stand in for
+void test_rdft_fixed_tracks_rdft()
+{
+    for (int n = 0; n < 256; n++)
+    {
+        floatInput[n] = fullScaleInput[n];
+    }
+    rdft(floatInput, 256, 256, floatPower);
+    int exponent = rdftFixed(fullScaleInput, 256, power);
+
+    float peak = 0.0f;
+    for (int k = 0; k <= 128; k++)
+    {
+        peak = floatPower[k] > peak ? floatPower[k] : peak;
+    }
+    for (int k = 0; k <= 128; k++)
+    {
+        float scaled = ldexpf((float)power[k], exponent);
+        TEST_ASSERT_FLOAT_WITHIN(1e-3f * peak, floatPower[k], scaled);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_rdft_fixed_gyro_vector);
+    RUN_TEST(test_rdft_fixed_full_scale_vector);
+    RUN_TEST(test_fixed_fft_complex_vector);
+    RUN_TEST(test_rdft_fixed_tracks_rdft);
+    RUN_TEST(test_rdft_fixed_rejects_bad_lengths);
+    return UNITY_END();
+}
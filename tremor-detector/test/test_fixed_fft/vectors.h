@@ -0,0 +1,125 @@
+#ifndef VECTORS_H
+#define VECTORS_H
+
+#include <stdint.h>
+
+/*
+Bit-exact regression vectors for the fixed-point path. The outputs were
+recorded from rdftFixed() and fixedFft() and must only change together
+with a deliberate change of their arithmetic.
+
+gyroInput: 64 raw gyro counts at 19 Hz, an offset, a 5 Hz tremor, a slow
+sway and noise.
+fullScaleInput: 256 points close to full scale, exercising the block
+scaling.
+complexInput: 32 point complex noise for fixedFft().
+*/
+
+static const int16_t gyroInput[64] = {
+    -408, 1484, -487, -1815, 577, 1498, -974, -1742, 642, 737,
+    -2021, -1819, 788, 158, -2362, -1180, 1340, 60, -1938, -121,
+    1659, -397, -1984, 318, 1199, -1449, -2140, 356, 595, -2053,
+    -1749, 982, 522, -1937, -682, 1694, 239, -1964, -238, 1506,
+    -759, -2361, -182, 934, -1665, -2221, 478, 799, -1717, -1379,
+    1351, 820, -1759, -706, 1524, -18, -2276, -646, 1012, -1060,
+    -2533, -55, 1050, -1303,
+};
+
+static const int32_t gyroPower[33] = {
+    5198700, 10491, 17725, 8447, 941335, 17107,
+    15135, 20509, 15753, 20221, 28140, 39307,
+    22846, 42969, 103860, 216517, 978130, 23616314,
+    376242, 96610, 48208, 26101, 15407, 15669,
+    4607, 3670, 1057, 702, 1935, 10,
+    2977, 144, 3,
+};
+
+#define GYRO_EXPONENT 1
+
+static const int16_t fullScaleInput[256] = {
+    50, 23819, 29486, 12653, -13294, -28851, -21281, 3554, 26472, 29768,
+    11810, -14230, -28043, -18515, 6760, 28513, 29934, 10233, -15660, -27467,
+    -16294, 9297, 29819, 29180, 8241, -17018, -27474, -15209, 10826, 29940,
+    27501, 5730, -19192, -28198, -13911, 12223, 29697, 25425, 2531, -22166,
+    -28938, -13092, 13036, 29139, 22771, -1375, -24623, -29790, -12629, 13864,
+    28212, 20405, -4271, -27209, -29886, -11166, 14424, 27874, 17900, -7466,
+    -28945, -29831, -9783, 16058, 27457, 15939, -9990, -29728, -28862, -7386,
+    18131, 27550, 14786, -11384, -30234, -27171, -4483, 20512, 28304, 13794,
+    -12613, -29737, -24584, -1176, 23130, 28961, 12763, -13361, -28759, -22098,
+    2410, 25427, 29831, 12166, -13798, -28024, -19394, 5663, 27667, 29899,
+    10799, -15090, -27511, -17146, 8262, 29517, 29451, 9037, -16729, -27405,
+    -15582, 10131, 29941, 28366, 6376, -18704, -28176, -14061, 11849, 29844,
+    26333, 3450, -21039, -28838, -13373, 12743, 29490, 23664, 74, -23781,
+    -29293, -12791, 13615, 28533, 21382, -3361, -26138, -30227, -11767, 14026,
+    27795, 18833, -6673, -28244, -29813, -10350, 15640, 27373, 16645, -9206,
+    -29847, -29125, -8243, 17103, 27483, 14748, -10785, -29852, -27491, -5348,
+    19691, 27966, 14180, -12234, -29881, -25536, -2484, 21836, 28897, 13101,
+    -12980, -29057, -23095, 1268, 24892, 29449, 12443, -13872, -28437, -20078,
+    4306, 27149, 30180, 11475, -14832, -27719, -17678, 7246, 28897, 29680,
+    9949, -15884, -27556, -15817, 9689, 29665, 28686, 7216, -17918, -27834,
+    -14569, 11442, 29896, 26986, 4340, -20254, -28560, -13897, 12220, 29618,
+    24631, 1264, -23163, -29180, -13044, 12991, 29122, 21952, -2326, -25456,
+    -29803, -12214, 13964, 28253, 19695, -5620, -27673, -30332, -10770, 15103,
+    27556, 17203, -8533, -29361, -29437, -8980, 16290, 27655, 15605, -10385,
+    -29825, -28101, -6569, 18887, 27930, 14165, -11811, -30201, -26253, -3564,
+    21321, 28596, 13339, -12507, -29703, -23982,
+};
+
+static const int32_t fullScalePower[129] = {
+    45, 3, 4, 190653, 3, 18,
+    13, 7, 7, 22, 1, 3,
+    10, 4, 6, 11, 3, 10,
+    1, 50, 11, 11, 4, 4,
+    8, 0, 25, 21, 10, 4,
+    1, 4, 10, 1, 4, 3,
+    0, 28085658, 13, 3, 20, 10,
+    8, 15, 30, 12, 1, 9,
+    7, 18, 3, 2, 2, 9,
+    11, 5, 1, 0, 6, 4,
+    15, 5, 5, 8, 9, 3,
+    14, 13, 16, 1, 12, 3,
+    2, 12, 6, 15, 15, 9,
+    0, 0, 11, 5, 16, 2,
+    9, 0, 38, 41, 22, 3,
+    15, 4, 21, 11, 8, 15,
+    3, 7, 29, 8, 5, 15,
+    22, 47, 14, 0, 9, 13,
+    38, 6, 11, 27, 15, 10,
+    1, 7, 7, 0, 3, 3,
+    21, 13, 17, 12, 16, 0,
+    17, 4, 10,
+};
+
+#define FULL_SCALE_EXPONENT 11
+
+static const int16_t complexInputReal[32] = {
+    -4124, 991, -7550, -3594, -5823, -6764, 2075, -7005, 1734, -40,
+    -7450, -6445, -4190, 6314, 6304, 5840, 7765, -8108, 447, 7051,
+    -2695, -3043, 2606, 4956, -4998, -1767, -5616, 6846, 5213, 3807,
+    -2439, -5355,
+};
+
+static const int16_t complexInputImag[32] = {
+    -1629, 1517, 235, 1317, -1664, -5168, 319, 3067, -5079, -1338,
+    -767, 113, -193, -5170, -5239, 4644, 32, 1307, -2425, -3459,
+    5398, 3221, -3971, -4310, -3800, 2644, -3945, 1872, 666, 1492,
+    5075, -1185,
+};
+
+static const int16_t complexOutputReal[32] = {
+    -3140, -5086, 1987, -5309, -45, 548, -3127, 5977, 121, -3801,
+    3435, 1394, 3317, -1502, -211, -1770, -1552, -1250, 1291, -4241,
+    1241, -4128, 2955, -1387, 1007, 2969, -1633, -2168, -577, -918,
+    2203, -3108,
+};
+
+static const int16_t complexOutputImag[32] = {
+    -2061, 4706, 4795, 684, 3162, -6359, -340, -7751, 1917, -1668,
+    1294, -516, -6158, -1140, 2732, 3068, -2193, -2110, -727, 4482,
+    346, 1761, -2486, 3077, -807, -2888, 3046, 4510, -4690, -694,
+    -1038, -2482,
+};
+
+#define COMPLEX_EXPONENT 3
+
+#endif /* VECTORS_H */
@@ -0,0 +1,131 @@
+#include <math.h>
+#include <unity.h>
+
+#include "dft.h"
+#include "goertzel.h"
+
+#define PI 3.1415926535897932385
+
+#define N 128
+#define SAMPLE_RATE 95
+
+static float history[N];
+static float window[N];
+static float power[N / 2 + 1];
+
+static unsigned int seed;
+
+static float nextSample(long n)
+{
+    seed = seed * 1103515245u + 12345u;
+    float noise = ((seed >> 16) & 0x7FFF) / 32768.0f - 0.5f;
+    float t = n / (float)SAMPLE_RATE;
+
+    // Large offset and slow sway to stress the recursion, plus a 5 Hz tremor
+    return 1000.0f + 30.0f * sinf(2 * PI * 0.4f * t) + 4.0f * sinf(2 * PI * 5.1f * t) + noise;
+}
+
+/*
+Compares every tracked bin with a full rdft() of the same window.
+tolerance = Allowed error relative to the strongest tracked bin
+*/
+static void checkAgainstRdft(const GoertzelBank &bank, long n, float tolerance)
+{
+    // Oldest sample first
+    for (int i = 0; i < N; i++)
+    {
+        window[i] = history[(n + 1 + i) % N];
+    }
+    rdft(window, N, N, power);
+
+    float peak = 0.0f;
+    for (int i = 0; i < bank.binCount(); i++)
+    {
+        float p = power[bank.firstBin() + i];
+        peak = p > peak ? p : peak;
+    }
+
+    float band = 0.0f;
+    for (int i = 0; i < bank.binCount(); i++)
+    {
+        float p = power[bank.firstBin() + i];
+        band += p;
+        TEST_ASSERT_FLOAT_WITHIN(tolerance * peak, p, bank.binPower(i));
+    }
+    TEST_ASSERT_FLOAT_WITHIN(tolerance * peak * bank.binCount(), band, bank.bandPower());
+}
+
+void setUp()
+{
+    seed = 1;
+}
+
+void tearDown()
+{
+}
+
+void test_bins_match_band()
+{
+    GoertzelBank bank(N, SAMPLE_RATE, 3.0f, 6.0f);
+
+    // floor(3 * 128 / 95) to ceil(6 * 128 / 95)
+    TEST_ASSERT_EQUAL_INT(4, bank.firstBin());
+    TEST_ASSERT_EQUAL_INT(6, bank.binCount());
+}
+
+void test_ready_after_one_window()
+{
+    GoertzelBank bank(N, SAMPLE_RATE, 3.0f, 6.0f);
+
+    for (long n = 0; n < N - 1; n++)
+    {
+        bank.update(nextSample(n));
+        TEST_ASSERT_FALSE(bank.ready());
+    }
+    bank.update(nextSample(N - 1));
+    TEST_ASSERT_TRUE(bank.ready());
+}
+
+void test_matches_rdft_every_sample()
+{
+    GoertzelBank bank(N, SAMPLE_RATE, 3.0f, 6.0f);
+
+    // Covers several hand-overs from the shadow bank, at every phase
+    for (long n = 0; n < 6 * N; n++)
+    {
+        history[n % N] = nextSample(n);
+        bank.update(history[n % N]);
+        if (n >= N - 1)
+        {
+            checkAgainstRdft(bank, n, 1e-3f);
+        }
+    }
+}
+
+void test_no_drift_over_long_run()
+{
+    GoertzelBank bank(N, SAMPLE_RATE, 3.0f, 6.0f);
+
+    // A full day at the sensor rate
+    long total = 24L * 3600 * SAMPLE_RATE;
+    for (long n = 0; n < total; n++)
+    {
+        history[n % N] = nextSample(n);
+        bank.update(history[n % N]);
+        if (n > N && n % 99991 == 0)
+        {
+            checkAgainstRdft(bank, n, 1e-3f);
+        }
+    }
+    checkAgainstRdft(bank, total - 1, 1e-3f);
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_bins_match_band);
+    RUN_TEST(test_ready_after_one_window);
+    RUN_TEST(test_matches_rdft_every_sample);
+    RUN_TEST(test_no_drift_over_long_run);
+    return UNITY_END();
+}
@@ -0,0 +1,91 @@
+#include <unity.h>
+
+#include "noisefloor.h"
+
+// As main.cpp
+#define SUBWINDOW 285
+#define SUBWINDOWS 8
+#define MIN_NOISE_FLOOR 14.0f
+#define TREMOR_SNR 4.0f
+
+static unsigned int seed;
+
+// Amplitude fluctuating up to spread either side of level
+static float nextLevel(float level, float spread)
+{
+    seed = seed * 1103515245u + 12345u;
+    return level + spread * (((seed >> 16) & 0x7FFF) / 16384.0f - 1.0f);
+}
+
+/*
+Feeds count amplitudes the way main.cpp does and counts the detections.
+Returns the number of samples above TREMOR_SNR times the floor
+*/
+static int feed(NoiseFloor<1, SUBWINDOWS> &floor, long count, float level, float spread)
+{
+    int detected = 0;
+    for (long n = 0; n < count; n++)
+    {
+        float power = nextLevel(level, spread);
+        floor.update(&power);
+        if (floor.snr(0, power, MIN_NOISE_FLOOR) > TREMOR_SNR)
+        {
+            detected++;
+        }
+    }
+    return detected;
+}
+
+void setUp()
+{
+    seed = 1;
+}
+
+void tearDown()
+{
+}
+
+// A resting baseline well above the thresholds from power on becomes the
+// floor instead of reading as a tremor that never ends
+void test_high_baseline_converges()
+{
+    NoiseFloor<1, SUBWINDOWS> floor(SUBWINDOW, 0.0f);
+
+    TEST_ASSERT_EQUAL_INT(0, feed(floor, 10, 300.0f, 30.0f));
+    TEST_ASSERT_EQUAL_INT(0, feed(floor, SUBWINDOW * SUBWINDOWS * 2, 300.0f, 30.0f));
+
+    // The floor settles on the bias times the smallest amplitude seen
+    TEST_ASSERT_FLOAT_WITHIN(0.05f * 1.5f * 270.0f, 1.5f * 270.0f, floor.floor(0));
+}
+
+// A short burst is ignored by the window minimum, so it still reads as a
+// tremor from start to end
+void test_burst_detected_over_baseline()
+{
+    NoiseFloor<1, SUBWINDOWS> floor(SUBWINDOW, 0.0f);
+    feed(floor, SUBWINDOW * SUBWINDOWS, 60.0f, 5.0f);
+
+    float before = floor.floor(0);
+    TEST_ASSERT_EQUAL_INT(SUBWINDOW * 2, feed(floor, SUBWINDOW * 2, 600.0f, 50.0f));
+    TEST_ASSERT_EQUAL_FLOAT(before, floor.floor(0));
+}
+
+// A lower baseline takes over the floor straight away
+void test_floor_follows_baseline_down()
+{
+    NoiseFloor<1, SUBWINDOWS> floor(SUBWINDOW, 0.0f);
+    feed(floor, SUBWINDOW * SUBWINDOWS, 300.0f, 30.0f);
+    feed(floor, SUBWINDOW, 20.0f, 2.0f);
+
+    TEST_ASSERT_FLOAT_WITHIN(0.1f * 1.5f * 18.0f, 1.5f * 18.0f, floor.floor(0));
+    TEST_ASSERT_EQUAL_INT(SUBWINDOW, feed(floor, SUBWINDOW, 200.0f, 10.0f));
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_high_baseline_converges);
+    RUN_TEST(test_burst_detected_over_baseline);
+    RUN_TEST(test_floor_follows_baseline_down);
+    return UNITY_END();
+}
@@ -0,0 +1,71 @@
+#include <unity.h>
+
+#include "samplering.h"
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+// The window is the last N samples, oldest first, across any number of wraps
+void test_window_is_contiguous_and_ordered()
+{
+    SampleRing<int, 8> ring;
+
+    for (int n = 1; n <= 29; n++)
+    {
+        ring.push(n);
+        const int *w = ring.window();
+        for (int i = 0; i < 8; i++)
+        {
+            int expected = n - 7 + i;
+            TEST_ASSERT_EQUAL_INT(expected > 0 ? expected : 0, w[i]);
+        }
+    }
+}
+
+// Due once on filling, then every hop samples
+void test_windows_are_due_every_hop()
+{
+    SampleRing<float, 16> ring(4);
+
+    for (int n = 1; n <= 64; n++)
+    {
+        bool due = ring.push((float)n);
+        bool expected = n >= 16 && (n - 16) % 4 == 0;
+        TEST_ASSERT_EQUAL(expected, due);
+        TEST_ASSERT_EQUAL(n >= 16, ring.full());
+    }
+}
+
+// A window chosen at run time only uses part of the storage
+void test_runtime_length()
+{
+    SampleRing<float, 32> ring(1, 5);
+    TEST_ASSERT_EQUAL_INT(5, ring.length());
+
+    for (int n = 1; n <= 12; n++)
+    {
+        TEST_ASSERT_EQUAL(n >= 5, ring.push((float)n));
+    }
+    for (int i = 0; i < 5; i++)
+    {
+        TEST_ASSERT_EQUAL_FLOAT(8.0f + i, ring.window()[i]);
+    }
+
+    ring.reset();
+    TEST_ASSERT_FALSE(ring.full());
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, ring.window()[4]);
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_window_is_contiguous_and_ordered);
+    RUN_TEST(test_windows_are_due_every_hop);
+    RUN_TEST(test_runtime_length);
+    return UNITY_END();
+}
@@ -0,0 +1,134 @@
+#include <stdint.h>
+#include <thread>
+#include <unity.h>
+
+#include "spsc.h"
+
+#define STRESS_ITEMS 2000000
+#define CHECK_MULTIPLIER 2654435761u
+
+// Shaped like GyroSample, with a check word derived from the sequence number
+struct Item
+{
+    uint32_t seq;
+    uint32_t check;
+    int16_t pad[3];
+};
+
+static SpscRing<Item, 64> ring;
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+void test_fills_to_capacity()
+{
+    SpscRing<int, 4> q;
+    int v;
+
+    TEST_ASSERT_TRUE(q.empty());
+    TEST_ASSERT_FALSE(q.pop(&v));
+    for (int i = 1; i <= 4; i++)
+    {
+        TEST_ASSERT_TRUE(q.push(i));
+    }
+    TEST_ASSERT_FALSE(q.push(5));
+    TEST_ASSERT_TRUE(q.claim() == nullptr);
+    TEST_ASSERT_EQUAL_INT(4, q.size());
+
+    TEST_ASSERT_TRUE(q.pop(&v));
+    TEST_ASSERT_EQUAL_INT(1, v);
+    TEST_ASSERT_EQUAL_INT(3, q.size());
+}
+
+void test_wraps_in_order()
+{
+    SpscRing<int, 4> q;
+    int out[4];
+    int next = 0, expected = 0;
+
+    // Indices run freely, so go round the ring many times
+    for (int round = 0; round < 1000; round++)
+    {
+        int pushed = 0;
+        while (pushed < 3 && q.push(next))
+        {
+            next++;
+            pushed++;
+        }
+
+        int n = q.pop(out, 2);
+        for (int i = 0; i < n; i++)
+        {
+            TEST_ASSERT_EQUAL_INT(expected++, out[i]);
+        }
+    }
+
+    int n;
+    while ((n = q.pop(out, 4)) > 0)
+    {
+        for (int i = 0; i < n; i++)
+        {
+            TEST_ASSERT_EQUAL_INT(expected++, out[i]);
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(next, expected);
+    TEST_ASSERT_TRUE(q.empty());
+}
+
+// Producer thread fills claimed slots in place, the consumer drains in batches
+void test_threaded_stress()
+{
+    std::thread producer([] {
+        for (uint32_t i = 0; i < STRESS_ITEMS;)
+        {
+            Item *slot = ring.claim();
+            if (slot == nullptr)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            slot->seq = i;
+            slot->check = i * CHECK_MULTIPLIER;
+            ring.publish();
+            i++;
+        }
+    });
+
+    Item batch[16];
+    uint32_t next = 0, errors = 0;
+    while (next < STRESS_ITEMS)
+    {
+        int n = ring.pop(batch, 16);
+        if (n == 0)
+        {
+            std::this_thread::yield();
+        }
+        for (int i = 0; i < n; i++)
+        {
+            if (batch[i].seq != next || batch[i].check != next * CHECK_MULTIPLIER)
+            {
+                errors++;
+            }
+            next++;
+        }
+    }
+    producer.join();
+
+    TEST_ASSERT_EQUAL_UINT32(0, errors);
+    TEST_ASSERT_EQUAL_UINT32(STRESS_ITEMS, next);
+    TEST_ASSERT_TRUE(ring.empty());
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_fills_to_capacity);
+    RUN_TEST(test_wraps_in_order);
+    RUN_TEST(test_threaded_stress);
+    return UNITY_END();
+}
@@ -0,0 +1,167 @@
+#include <math.h>
+#include <unity.h>
+
+#include "decimator.h"
+#include "tremor.h"
+
+#define PI 3.1415926535897932385
+
+#define SENSOR_RATE 95
+#define DECIMATION 5
+#define CONVERSION_FACTOR (0.0174533f) // As main.cpp, raw counts to velocity
+
+#define THRESHOLD 56.0f  // TREMOR_SNR times MIN_NOISE_FLOOR in main.cpp
+#define SETTLE 10.0f     // Seconds of sensor noise before the tremor starts
+#define PHASES 16        // Onset phases averaged per amplitude
+
+static unsigned int seed;
+
+// Integer sensor noise of up to 2 either way
+static float nextNoise()
+{
+    seed = seed * 1103515245u + 12345u;
+    return (float)((seed >> 16) % 5) - 2.0f;
+}
+
+/*
+Runs a tremor starting after SETTLE seconds of noise through the whole
+chain: sensor rate, Decimator, velocity conversion and TremorFilter.
+amplitude = Tremor amplitude of the velocity
+freq = Tremor frequency in Hz
+phase = Phase of the tremor at onset
+steady = Receives the mean amplitude from 10 s after onset on
+
+Returns the seconds from onset until the amplitude first exceeds THRESHOLD,
+or -1 if it never does
+*/
+static float onsetLatency(float amplitude, float freq, float phase, float *steady)
+{
+    Decimator<DECIMATION> decimator;
+    TremorFilter tremor;
+    float onset = -1.0f;
+    double sum = 0.0;
+    int count = 0;
+
+    for (long n = 0; n < (long)(SENSOR_RATE * (SETTLE + 20)); n++)
+    {
+        float t = n / (float)SENSOR_RATE - SETTLE;
+        float velocity = nextNoise();
+        if (t >= 0.0f)
+        {
+            velocity += amplitude * sinf(2 * PI * freq * t + phase);
+        }
+
+        float raw;
+        if (!decimator.push(velocity / CONVERSION_FACTOR, &raw))
+        {
+            continue;
+        }
+
+        float level = tremor.push(int16_t(raw * CONVERSION_FACTOR), true);
+        if (t >= 0.0f && onset < 0.0f && level > THRESHOLD)
+        {
+            onset = t;
+        }
+        if (t >= 10.0f)
+        {
+            sum += level;
+            count++;
+        }
+    }
+
+    *steady = sum / count;
+    return onset;
+}
+
+// Mean onset latency over PHASES onset phases, -1 if any of them misses
+static float meanOnsetLatency(float amplitude, float freq)
+{
+    float total = 0.0f;
+    float steady;
+    for (int p = 0; p < PHASES; p++)
+    {
+        float onset = onsetLatency(amplitude, freq, p * 2 * PI / PHASES, &steady);
+        if (onset < 0.0f)
+        {
+            return -1.0f;
+        }
+        total += onset;
+    }
+    return total / PHASES;
+}
+
+void setUp()
+{
+    seed = 1;
+}
+
+void tearDown()
+{
+}
+
+// Onset latency through the full chain for a 5 Hz tremor, measured at
+// 0.68, 0.62 and 0.57 s. The rectified average it replaced fired after
+// 0.74, 0.62 and 0.38 s, most of what is left is the decimator delay
+void test_onset_latency()
+{
+    float latency80 = meanOnsetLatency(80.0f, 5.0f);
+    float latency100 = meanOnsetLatency(100.0f, 5.0f);
+    float latency150 = meanOnsetLatency(150.0f, 5.0f);
+
+    TEST_ASSERT_TRUE(latency80 > 0.0f && latency80 < 0.72f);
+    TEST_ASSERT_TRUE(latency100 > 0.0f && latency100 < 0.66f);
+    TEST_ASSERT_TRUE(latency150 > 0.0f && latency150 < 0.61f);
+    TEST_ASSERT_TRUE(latency150 <= latency100 && latency100 <= latency80);
+}
+
+// A tremor of half the threshold and sensor noise alone never fire
+void test_small_tremor_not_detected()
+{
+    float steady;
+    for (int p = 0; p < PHASES; p++)
+    {
+        TEST_ASSERT_TRUE(onsetLatency(28.0f, 5.0f, p * 2 * PI / PHASES, &steady) < 0.0f);
+        TEST_ASSERT_TRUE(onsetLatency(0.0f, 5.0f, 0.0f, &steady) < 0.0f);
+    }
+}
+
+// The amplitude reads the tremor amplitude across the pass band and
+// falls away above it
+void test_steady_amplitude()
+{
+    float steady;
+    for (float freq = 4.0f; freq <= 5.0f; freq += 0.5f)
+    {
+        onsetLatency(100.0f, freq, 0.0f, &steady);
+        TEST_ASSERT_FLOAT_WITHIN(8.0f, 100.0f, steady);
+    }
+
+    onsetLatency(100.0f, 3.0f, 0.0f, &steady);
+    TEST_ASSERT_FLOAT_WITHIN(10.0f, 75.0f, steady);
+
+    onsetLatency(100.0f, 7.0f, 0.0f, &steady);
+    TEST_ASSERT_TRUE(steady < 0.4f * THRESHOLD);
+}
+
+// Movement on the other axes blanks the amplitude
+void test_unsteady_reads_zero()
+{
+    TremorFilter tremor;
+    for (int n = 0; n < 100; n++)
+    {
+        int16_t velocity = int16_t(100.0f * sinf(2 * PI * 5.0f * n / (SENSOR_RATE / DECIMATION)));
+        tremor.push(velocity, true);
+    }
+    TEST_ASSERT_TRUE(tremor.amplitude() > THRESHOLD);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, tremor.push(0, false));
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_onset_latency);
+    RUN_TEST(test_small_tremor_not_detected);
+    RUN_TEST(test_steady_amplitude);
+    RUN_TEST(test_unsteady_reads_zero);
+    return UNITY_END();
+}